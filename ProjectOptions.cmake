@@ -29,6 +29,8 @@ macro(lefticus_tools_setup_options)
 
   lefticus_tools_check_libfuzzer_support(LIBFUZZER_SUPPORTED)
   option(lefticus_tools_BUILD_FUZZ_TESTS "Enable fuzz testing executable" ${LIBFUZZER_SUPPORTED})
+  option(lefticus_tools_BUILD_COMPILE_BENCHMARKS "Enable the compile-time benchmark target" OFF)
+  option(lefticus_tools_BUILD_BENCHMARKS "Enable the runtime benchmark executable" OFF)
 
 
   if(NOT PROJECT_IS_TOP_LEVEL OR lefticus_tools_PACKAGING_MAINTAINER_MODE)
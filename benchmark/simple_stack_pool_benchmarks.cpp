@@ -0,0 +1,80 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/simple_stack_pool.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+namespace {
+struct particle
+{
+  double x{};
+  double y{};
+  double dx{};
+  double dy{};
+};
+
+constexpr std::size_t object_count = 256;
+
+// release in a scrambled order, so the free list does not just hand back
+// the same slot over and over
+constexpr auto release_order = [] {
+  std::array<std::size_t, object_count> result{};
+  for (std::size_t index = 0; index < object_count; ++index) { result[index] = (index * 97) % object_count; }
+  return result;
+}();
+}// namespace
+
+TEST_CASE("[simple_stack_pool] acquire and release compared to new and std::allocator")
+{
+  BENCHMARK_ADVANCED("simple_stack_pool")(Catch::Benchmark::Chronometer meter)
+  {
+    lefticus::tools::simple_stack_pool<particle, object_count> pool;
+    std::array<particle *, object_count> objects{};
+    meter.measure([&] {
+      for (std::size_t index = 0; index < object_count; ++index) {
+        objects[index] = pool.acquire(particle{ static_cast<double>(index) });
+      }
+      double total = 0;
+      for (const auto index : release_order) {
+        total += objects[index]->x;
+        pool.release(objects[index]);
+      }
+      return total;
+    });
+  };
+
+  BENCHMARK_ADVANCED("new and delete")(Catch::Benchmark::Chronometer meter)
+  {
+    std::array<particle *, object_count> objects{};
+    meter.measure([&] {
+      for (std::size_t index = 0; index < object_count; ++index) {
+        objects[index] = new particle{ static_cast<double>(index) };// NOLINT (owning raw pointer)
+      }
+      double total = 0;
+      for (const auto index : release_order) {
+        total += objects[index]->x;
+        delete objects[index];// NOLINT (owning raw pointer)
+      }
+      return total;
+    });
+  };
+
+  BENCHMARK_ADVANCED("std::allocator")(Catch::Benchmark::Chronometer meter)
+  {
+    std::allocator<particle> allocator;
+    std::array<particle *, object_count> objects{};
+    meter.measure([&] {
+      for (std::size_t index = 0; index < object_count; ++index) {
+        objects[index] = std::construct_at(allocator.allocate(1), particle{ static_cast<double>(index) });
+      }
+      double total = 0;
+      for (const auto index : release_order) {
+        total += objects[index]->x;
+        std::destroy_at(objects[index]);
+        allocator.deallocate(objects[index], 1);
+      }
+      return total;
+    });
+  };
+}
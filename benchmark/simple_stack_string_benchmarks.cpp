@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/simple_stack_string.hpp>
+
+#include <string_view>
+
+namespace {
+// ordinary text filling the string, with everything being searched for
+// only at the very end
+template<std::size_t Capacity> lefticus::tools::simple_stack_string<Capacity> make_text()
+{
+  lefticus::tools::simple_stack_string<Capacity> result;
+  constexpr std::string_view words = "the quick brown fox jumps over the lazy dog ";
+  constexpr std::string_view end = "=;|\"needle";
+  while (result.size() < result.capacity() - end.size()) { result.push_back(words[result.size() % words.size()]); }
+  result.append(end);
+  return result;
+}
+
+template<std::size_t Capacity> void compare_searches(const lefticus::tools::simple_stack_string<Capacity> &text)
+{
+  const std::string_view view{ text };
+
+  // the texts are read back through a volatile pointer, so the searches
+  // cannot be hoisted out of the benchmark loop
+  const auto *volatile text_ptr = &text;
+  const auto *volatile view_ptr = &view;
+
+  BENCHMARK("find(char) simple_stack_string") { return text_ptr->find('='); };
+  BENCHMARK("find(char) std::string_view") { return view_ptr->find('='); };
+
+  BENCHMARK("find(string) simple_stack_string") { return text_ptr->find(std::string_view{ "needle" }); };
+  BENCHMARK("find(string) std::string_view") { return view_ptr->find(std::string_view{ "needle" }); };
+
+  BENCHMARK("rfind(char) simple_stack_string") { return text_ptr->rfind('!'); };
+  BENCHMARK("rfind(char) std::string_view") { return view_ptr->rfind('!'); };
+
+  constexpr std::string_view two_chars{ "=;" };
+  constexpr std::string_view three_chars{ "=;|" };
+  constexpr std::string_view six_chars{ "=;|\"<>" };
+
+  BENCHMARK("find_first_of(2 chars) simple_stack_string") { return text_ptr->find_first_of(two_chars); };
+  BENCHMARK("find_first_of(2 chars) std::string_view") { return view_ptr->find_first_of(two_chars); };
+
+  BENCHMARK("find_first_of(3 chars) simple_stack_string") { return text_ptr->find_first_of(three_chars); };
+  BENCHMARK("find_first_of(3 chars) std::string_view") { return view_ptr->find_first_of(three_chars); };
+
+  BENCHMARK("find_first_of(6 chars) simple_stack_string") { return text_ptr->find_first_of(six_chars); };
+  BENCHMARK("find_first_of(6 chars) std::string_view") { return view_ptr->find_first_of(six_chars); };
+}
+}// namespace
+
+// near capacity, where the 8 at a time searches have the most to skip
+TEST_CASE("[simple_stack_string] searches compared to std::string_view")
+{
+  compare_searches(make_text<1000>());// NOLINT Magic Number
+}
+
+// 23 characters, where setting up the word search costs the most relative to the search
+TEST_CASE("[simple_stack_string] searches on short strings compared to std::string_view")
+{
+  compare_searches(make_text<24>());// NOLINT Magic Number
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/split.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace {
+// what any_of_delimiter does for every set during constant evaluation,
+// one bitmap lookup per character
+struct bitmap_delimiter
+{
+  lefticus::tools::basic_char_bitmap<char> set;
+
+  [[nodiscard]] constexpr std::size_t find_in(const std::string_view text) const noexcept
+  {
+    for (std::size_t idx = 0; idx < text.size(); ++idx) {
+      if (set.contains(text[idx])) { return idx; }
+    }
+    return std::string_view::npos;
+  }
+
+  [[nodiscard]] constexpr bool matches(const char c) const noexcept { return set.contains(c); }
+};
+
+// std::string_view::find_first_of for every piece
+struct find_first_of_delimiter
+{
+  std::string_view delimiters;
+
+  [[nodiscard]] constexpr std::size_t find_in(const std::string_view text) const noexcept
+  {
+    return text.find_first_of(delimiters);
+  }
+
+  [[nodiscard]] constexpr bool matches(const char c) const noexcept
+  {
+    return delimiters.find(c) != std::string_view::npos;
+  }
+};
+
+// rows of a CSV file, with fields of typical lengths
+std::string make_csv()
+{
+  std::string result;
+  for (std::size_t row = 0; row < 200; ++row) {// NOLINT Magic Number
+    result += "customer_" + std::to_string(row) + ",2024-01-" + std::to_string(row % 28 + 1)// NOLINT Magic Number
+              + ",some free text describing the order," + std::to_string(row * 37) + "\n";// NOLINT Magic Number
+  }
+  return result;
+}
+
+// a request line and headers, as read from a socket
+std::string make_request()
+{
+  std::string result = "GET /api/v1/customers/12345/orders?status=open&limit=50 HTTP/1.1\r\n";
+  for (std::size_t header = 0; header < 20; ++header) {// NOLINT Magic Number
+    result += "X-Header-" + std::to_string(header) + ": a header value of moderate length\r\n";
+  }
+  return result;
+}
+
+template<typename Delimiter>
+std::size_t count_pieces(const std::string_view text, const Delimiter delimiter, const bool skip_empty)
+{
+  lefticus::tools::basic_splitter<char, Delimiter> splitter{ text, delimiter, { .skip_empty = skip_empty } };
+  std::size_t result = 0;
+  while (splitter.next()) { ++result; }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[split] any of a few delimiters compared to a bitmap and find_first_of")
+{
+  const auto csv = make_csv();
+  const auto request = make_request();
+
+  // the texts are read back through volatile pointers, so the splits
+  // cannot be hoisted out of the benchmark loop
+  const std::string_view csv_view{ csv };
+  const std::string_view request_view{ request };
+  const auto *volatile csv_ptr = &csv_view;
+  const auto *volatile request_ptr = &request_view;
+
+  constexpr std::string_view csv_delimiters{ ",\n" };
+  constexpr std::string_view request_delimiters{ " \r\n" };
+
+  const lefticus::tools::any_of_delimiter<char> csv_any_of{ csv_delimiters };
+  const bitmap_delimiter csv_bitmap{ lefticus::tools::basic_char_bitmap<char>{ csv_delimiters } };
+  const find_first_of_delimiter csv_find_first_of{ csv_delimiters };
+
+  const lefticus::tools::any_of_delimiter<char> request_any_of{ request_delimiters };
+  const bitmap_delimiter request_bitmap{ lefticus::tools::basic_char_bitmap<char>{ request_delimiters } };
+  const find_first_of_delimiter request_find_first_of{ request_delimiters };
+
+  REQUIRE(count_pieces(csv_view, csv_any_of, false) == count_pieces(csv_view, csv_bitmap, false));
+  REQUIRE(count_pieces(request_view, request_any_of, true) == count_pieces(request_view, request_bitmap, true));
+
+  BENCHMARK("CSV any_of_delimiter") { return count_pieces(*csv_ptr, csv_any_of, false); };
+  BENCHMARK("CSV bitmap") { return count_pieces(*csv_ptr, csv_bitmap, false); };
+  BENCHMARK("CSV std::string_view::find_first_of") { return count_pieces(*csv_ptr, csv_find_first_of, false); };
+
+  BENCHMARK("request any_of_delimiter") { return count_pieces(*request_ptr, request_any_of, true); };
+  BENCHMARK("request bitmap") { return count_pieces(*request_ptr, request_bitmap, true); };
+  BENCHMARK("request std::string_view::find_first_of")
+  {
+    return count_pieces(*request_ptr, request_find_first_of, true);
+  };
+}
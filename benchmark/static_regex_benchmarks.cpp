@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/static_regex.hpp>
+
+#include <cstddef>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+// "key<n>=<digits>", every third one with a trailing '!' so it only
+// matches as a search
+std::vector<std::string> make_inputs()
+{
+  std::vector<std::string> result;
+  for (int index = 0; index < 1000; ++index) {// NOLINT Magic Number
+    result.push_back("key" + std::to_string(index) + "=" + std::to_string(index * 7919)// NOLINT Magic Number
+                     + (index % 3 == 0 ? "!" : ""));
+  }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[static_regex] matching compared to std::regex")
+{
+  using regex = lefticus::tools::static_regex<"[a-z]+\\d*=\\d+">;
+  const std::regex std_regex{ "[a-z]+\\d*=\\d+", std::regex::optimize };
+
+  const auto inputs = make_inputs();
+  // the inputs are read back through a volatile pointer, so the matches
+  // cannot be hoisted out of the benchmark loop
+  const auto *volatile inputs_ptr = &inputs;
+
+  BENCHMARK("match static_regex")
+  {
+    std::size_t matches = 0;
+    for (const auto &input : *inputs_ptr) { matches += regex::match(input) ? 1U : 0U; }
+    return matches;
+  };
+
+  BENCHMARK("match std::regex")
+  {
+    std::size_t matches = 0;
+    for (const auto &input : *inputs_ptr) { matches += std::regex_match(input, std_regex) ? 1U : 0U; }
+    return matches;
+  };
+
+  BENCHMARK("search static_regex")
+  {
+    std::size_t matches = 0;
+    for (const auto &input : *inputs_ptr) { matches += regex::search(input).has_value() ? 1U : 0U; }
+    return matches;
+  };
+
+  BENCHMARK("search std::regex")
+  {
+    std::size_t matches = 0;
+    for (const auto &input : *inputs_ptr) { matches += std::regex_search(input, std_regex) ? 1U : 0U; }
+    return matches;
+  };
+}
+
+TEST_CASE("[static_regex] search without a match")
+{
+  // every start position begins a match that fails only at the very end
+  const std::string text(10000, 'a');// NOLINT Magic Number
+  const auto *volatile text_ptr = &text;
+
+  BENCHMARK("a*b in 10000 a's static_regex")
+  {
+    return lefticus::tools::static_regex<"a*b">::search(*text_ptr).has_value();
+  };
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/static_views.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+constexpr std::size_t keyword_count = 300;
+using identifier = lefticus::tools::simple_stack_string<16>;
+
+// identifiers of 3 to 12 characters, from a simple LCG; made once, so
+// building the matcher does not spend its constexpr budget on them
+constexpr std::array<identifier, keyword_count> make_identifiers(std::uint64_t seed)
+{
+  constexpr std::string_view alphabet = "abcdefghijklmnopqrstuvwxyz_";
+  const auto next = [&seed] {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;// NOLINT Magic Number
+    return std::size_t{ seed >> 33U };// NOLINT Magic Number
+  };
+
+  std::array<identifier, keyword_count> result{};
+  for (auto &str : result) {
+    const auto length = 3 + next() % 10;// NOLINT Magic Number
+    while (str.size() < length) { str.push_back(alphabet[next() % alphabet.size()]); }
+  }
+  return result;
+}
+
+constexpr auto keywords = make_identifiers(42);// NOLINT Magic Number
+constexpr auto misses = make_identifiers(4242);// NOLINT Magic Number
+
+// keywords and other identifiers, alternating
+std::vector<std::string> make_inputs()
+{
+  std::vector<std::string> result;
+  for (std::size_t index = 0; index < keyword_count; ++index) {
+    result.emplace_back(keywords[index]);
+    result.emplace_back(misses[index]);
+  }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[to_keyword_matcher] lookups compared to std::unordered_set")
+{
+  static constexpr auto matcher = lefticus::tools::to_keyword_matcher([] { return keywords; });
+  const std::unordered_set<std::string_view> keyword_set(keywords.begin(), keywords.end());
+
+  const auto inputs = make_inputs();
+  // the inputs are read back through a volatile pointer, so the lookups
+  // cannot be hoisted out of the benchmark loop
+  const auto *volatile inputs_ptr = &inputs;
+
+  REQUIRE(matcher.contains(keywords.front()));
+  REQUIRE(
+    std::ranges::count_if(inputs, [&](const auto &input) { return matcher.contains(input); })
+    == std::ranges::count_if(inputs, [&](const auto &input) { return keyword_set.contains(input); }));
+
+  BENCHMARK("static_keyword_matcher")
+  {
+    std::size_t found = 0;
+    for (const auto &input : *inputs_ptr) { found += matcher.contains(input) ? 1U : 0U; }
+    return found;
+  };
+
+  BENCHMARK("std::unordered_set<std::string_view>")
+  {
+    std::size_t found = 0;
+    for (const auto &input : *inputs_ptr) { found += keyword_set.contains(input) ? 1U : 0U; }
+    return found;
+  };
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/string_switch.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+constexpr std::array<std::string_view, 16> commands{ "get",
+  "set",
+  "delete",
+  "list",
+  "push",
+  "pop",
+  "peek",
+  "clear",
+  "append",
+  "prepend",
+  "insert",
+  "erase",
+  "find",
+  "count",
+  "status",
+  "quit" };
+
+constexpr std::size_t no_command = static_cast<std::size_t>(-1);
+
+// what the string_switch replaces
+std::size_t if_chain(const std::string_view input)
+{
+  if (input == "get") { return 0; }
+  if (input == "set") { return 1; }
+  if (input == "delete") { return 2; }
+  if (input == "list") { return 3; }
+  if (input == "push") { return 4; }
+  if (input == "pop") { return 5; }
+  if (input == "peek") { return 6; }// NOLINT Magic Number
+  if (input == "clear") { return 7; }// NOLINT Magic Number
+  if (input == "append") { return 8; }// NOLINT Magic Number
+  if (input == "prepend") { return 9; }// NOLINT Magic Number
+  if (input == "insert") { return 10; }// NOLINT Magic Number
+  if (input == "erase") { return 11; }// NOLINT Magic Number
+  if (input == "find") { return 12; }// NOLINT Magic Number
+  if (input == "count") { return 13; }// NOLINT Magic Number
+  if (input == "status") { return 14; }// NOLINT Magic Number
+  if (input == "quit") { return 15; }// NOLINT Magic Number
+  return no_command;
+}
+
+// every command once, plus as many near misses
+std::array<std::string, 32> make_inputs()
+{
+  std::array<std::string, 32> result{};
+  for (std::size_t index = 0; index < commands.size(); ++index) {
+    result[index * 2] = std::string{ commands[index] };
+    result[index * 2 + 1] = std::string{ commands[index] } + "s";
+  }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[string_switch] lookups compared to an if chain and std::unordered_map")
+{
+  static constexpr auto command_switch = lefticus::tools::to_string_switch([] { return commands; });
+
+  std::unordered_map<std::string_view, std::size_t> command_map;
+  for (std::size_t index = 0; index < commands.size(); ++index) { command_map.emplace(commands[index], index); }
+
+  const auto inputs = make_inputs();
+  // the inputs are read back through a volatile pointer, so the lookups
+  // cannot be hoisted out of the benchmark loop
+  const auto *volatile inputs_ptr = &inputs;
+
+  REQUIRE(command_switch("status") == if_chain("status"));
+  REQUIRE(command_switch("statuss") == if_chain("statuss"));
+
+  BENCHMARK("string_switch")
+  {
+    std::size_t total = 0;
+    for (const auto &input : *inputs_ptr) { total += command_switch(input); }
+    return total;
+  };
+
+  BENCHMARK("if chain")
+  {
+    std::size_t total = 0;
+    for (const auto &input : *inputs_ptr) { total += if_chain(input); }
+    return total;
+  };
+
+  BENCHMARK("std::unordered_map")
+  {
+    std::size_t total = 0;
+    for (const auto &input : *inputs_ptr) {
+      const auto found = command_map.find(input);
+      total += found == command_map.end() ? no_command : found->second;
+    }
+    return total;
+  };
+}
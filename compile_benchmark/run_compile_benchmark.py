@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""Compile-time cost benchmark for the constexpr and type list facilities.
+
+For every facility and input size a translation unit is generated and
+compiled with -fsyntax-only, recording:
+  * wall time (best of --repeat runs)
+  * peak resident set size of the compiler (highest of the --repeat runs)
+  * the compiler's own phase breakdown: -ftime-trace totals for clang,
+    -ftime-report wall times for GCC
+
+The results are written as a JSON report, so they can be diffed between
+commits to find regressions in constexpr evaluation cost.
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+
+def make_minimized_stackify(size):
+    return f"""#include <lefticus/tools/static_views.hpp>
+#include <vector>
+
+constexpr auto make_data()
+{{
+  std::vector<int> result;
+  for (int value = 0; value < {size}; ++value) {{ result.push_back(value); }}
+  return result;
+}}
+
+constexpr auto data = lefticus::tools::minimized_stackify<{size}>([] {{ return make_data(); }});
+static_assert(data.size() == {size});
+"""
+
+
+def make_to_span(size):
+    return f"""#include <lefticus/tools/static_views.hpp>
+#include <vector>
+
+constexpr auto data = lefticus::tools::to_span([] {{
+  std::vector<int> result;
+  for (int value = 0; value < {size}; ++value) {{ result.push_back(value); }}
+  return result;
+}});
+static_assert(data.size() == {size});
+"""
+
+
+def make_to_string_view(size):
+    return f"""#include <lefticus/tools/static_views.hpp>
+#include <string>
+
+constexpr auto data = lefticus::tools::to_string_view([] {{
+  std::string result;
+  for (int value = 0; value < {size}; ++value) {{ result.push_back(static_cast<char>('a' + value % 26)); }}
+  return result;
+}});
+static_assert(data.size() == {size});
+"""
+
+
+def make_type_list(size):
+    types = ", ".join(f"std::integral_constant<int, {index}>" for index in range(size))
+    return f"""#include <lefticus/tools/type_lists.hpp>
+#include <type_traits>
+
+using list = lefticus::tools::type_list<{types}>;
+"""
+
+
+def make_nth_t(size):
+    # size - 2 avoids the shortcut for the last element
+    index = max(size - 2, 0)
+    return make_type_list(size) + f"""
+static_assert(std::is_same_v<lefticus::tools::nth_t<{index}, list>, std::integral_constant<int, {index}>>);
+"""
+
+
+def make_split_n_t(size):
+    index = size // 2
+    return make_type_list(size) + f"""
+using split = lefticus::tools::split_n_t<{index}, list>;
+static_assert(std::is_same_v<lefticus::tools::nth_t<0, split::second_type>, std::integral_constant<int, {index}>>);
+"""
+
+
+def make_curry(size):
+    # every lambda is a distinct type, so each line is a new set of instantiations
+    lines = [
+        f"static_assert(lefticus::tools::curry([](int x, int y, int z) {{ return x + y + z + {index}; }})(1)(2)(3) == {index + 6});"
+        for index in range(size)
+    ]
+    return "#include <lefticus/tools/curry.hpp>\n\n" + "\n".join(lines) + "\n"
+
+
+FACILITIES = {
+    "minimized_stackify": make_minimized_stackify,
+    "to_span": make_to_span,
+    "to_string_view": make_to_string_view,
+    "nth_t": make_nth_t,
+    "split_n_t": make_split_n_t,
+    "curry": make_curry,
+}
+
+GCC_TIME_REPORT_ROW = re.compile(
+    r"^\s*(?P<name>[^:]+?)\s*:\s*[\d.]+\s*\(\s*\d+%\)\s*[\d.]+\s*\(\s*\d+%\)\s*(?P<wall>[\d.]+)\s*\(\s*\d+%\)"
+)
+
+
+def compiler_version(compiler):
+    result = subprocess.run([compiler, "--version"], capture_output=True, text=True, check=True)
+    return result.stdout.splitlines()[0]
+
+
+def is_clang(version):
+    return "clang" in version.lower()
+
+
+def run_measured(command, timeout):
+    """Runs command, returning (exit code or None on timeout, wall seconds, peak RSS in KiB, stderr)."""
+    with tempfile.TemporaryFile() as stderr_file:
+        start = time.perf_counter()
+        # own session, so a timeout also takes down cc1plus and friends
+        process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=stderr_file, start_new_session=True)
+
+        # wait4 gives the rusage of this one child, where RUSAGE_CHILDREN
+        # would be the maximum over every compile so far
+        while True:
+            pid, status, usage = os.wait4(process.pid, os.WNOHANG)
+            if pid != 0:
+                break
+            if time.perf_counter() - start > timeout:
+                os.killpg(process.pid, signal.SIGKILL)
+                os.wait4(process.pid, 0)
+                process.returncode = -1
+                return None, float(timeout), 0, "timed out"
+            time.sleep(0.005)
+
+        wall = time.perf_counter() - start
+        process.returncode = os.waitstatus_to_exitcode(status)
+
+        stderr_file.seek(0)
+        stderr = stderr_file.read().decode(errors="replace")
+
+    max_rss = usage.ru_maxrss
+    # Linux reports KiB, macOS reports bytes
+    if platform.system() == "Darwin":
+        max_rss //= 1024
+    return process.returncode, wall, max_rss, stderr
+
+
+def parse_clang_time_trace(trace_file):
+    with open(trace_file, encoding="utf-8") as file:
+        trace = json.load(file)
+    totals = {}
+    for event in trace.get("traceEvents", []):
+        name = event.get("name", "")
+        if name.startswith("Total "):
+            totals[name[len("Total ") :]] = event.get("dur", 0) / 1e6
+    return totals
+
+
+def parse_gcc_time_report(stderr):
+    totals = {}
+    for line in stderr.splitlines():
+        match = GCC_TIME_REPORT_ROW.match(line)
+        if match:
+            totals[match.group("name").lstrip("|")] = float(match.group("wall"))
+    return totals
+
+
+def benchmark(args, facility, size, clang):
+    source = args.work_dir / f"{facility}_{size}.cpp"
+    source.write_text(FACILITIES[facility](size), encoding="utf-8")
+
+    command = [
+        args.compiler,
+        f"-std={args.std}",
+        f"-I{args.include_dir}",
+        # the type list facilities recurse once per element
+        f"-ftemplate-depth={size + 1024}",
+        "-fsyntax-only",
+        str(source),
+    ]
+
+    # the fastest wall time, but the highest peak memory of any run
+    best_wall = None
+    peak_rss = 0
+    for _ in range(args.repeat):
+        exit_code, wall, max_rss, stderr = run_measured(command, args.timeout)
+        if exit_code != 0:
+            return {
+                "facility": facility,
+                "size": size,
+                "status": "timeout" if exit_code is None else "failed",
+                "wall_seconds": wall,
+                "peak_rss_kib": max_rss,
+                "error": stderr[-2000:],
+            }
+        if best_wall is None or wall < best_wall:
+            best_wall = wall
+        peak_rss = max(peak_rss, max_rss)
+
+    # one more run for the phase breakdown, so the tracing does not skew the timing
+    if clang:
+        trace_file = args.work_dir / f"{facility}_{size}.json"
+        run_measured(
+            command[:-2] + ["-c", str(source), "-o", str(args.work_dir / f"{facility}_{size}.o"), "-ftime-trace"],
+            args.timeout,
+        )
+        phases = parse_clang_time_trace(trace_file) if trace_file.exists() else {}
+    else:
+        _, _, _, stderr = run_measured(command + ["-ftime-report"], args.timeout)
+        phases = parse_gcc_time_report(stderr)
+
+    return {
+        "facility": facility,
+        "size": size,
+        "status": "ok",
+        "wall_seconds": best_wall,
+        "peak_rss_kib": peak_rss,
+        "phases_seconds": phases,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--include-dir", type=Path, required=True)
+    parser.add_argument("--std", default="c++20")
+    parser.add_argument("--sizes", default="10,100,1000,10000", help="comma separated input sizes")
+    parser.add_argument("--facilities", default=",".join(FACILITIES), help="comma separated subset to run")
+    parser.add_argument(
+        "--repeat", type=int, default=3, help="report the best wall time and highest peak memory of this many runs"
+    )
+    parser.add_argument("--timeout", type=int, default=600, help="seconds allowed for a single compile")
+    parser.add_argument("--work-dir", type=Path, required=True, help="where generated sources are written")
+    parser.add_argument("--output", type=Path, required=True, help="JSON report to write")
+    parser.add_argument(
+        "--allow-failures", action="store_true", help="exit successfully even if some sizes fail to compile"
+    )
+    args = parser.parse_args()
+
+    args.work_dir.mkdir(parents=True, exist_ok=True)
+    sizes = [int(size) for size in args.sizes.split(",") if size]
+    facilities = [facility for facility in args.facilities.split(",") if facility]
+    for facility in facilities:
+        if facility not in FACILITIES:
+            parser.error(f"unknown facility '{facility}', expected one of {', '.join(FACILITIES)}")
+
+    version = compiler_version(args.compiler)
+    clang = is_clang(version)
+
+    results = []
+    for facility in facilities:
+        for size in sizes:
+            result = benchmark(args, facility, size, clang)
+            results.append(result)
+            print(
+                f"{facility:>20} {size:>6}: {result['status']:>7} "
+                f"{result['wall_seconds']:8.2f} s {result['peak_rss_kib'] // 1024:6} MiB",
+                flush=True,
+            )
+
+    report = {
+        "compiler": args.compiler,
+        "compiler_version": version,
+        "std": args.std,
+        "phase_source": "-ftime-trace" if clang else "-ftime-report",
+        "results": results,
+    }
+    args.output.write_text(json.dumps(report, indent=2) + "\n", encoding="utf-8")
+    print(f"report written to {args.output}")
+
+    return 0 if all(result["status"] == "ok" for result in results) or args.allow_failures else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
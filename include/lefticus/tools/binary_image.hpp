@@ -0,0 +1,306 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_BINARY_IMAGE_HPP
+#define LEFTICUS_TOOLS_BINARY_IMAGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hash.hpp"
+#include "simple_stack_flat_map.hpp"
+#include "simple_stack_string.hpp"
+#include "simple_stack_vector.hpp"
+#include "utility.hpp"
+
+namespace lefticus::tools {
+
+// Describes how a type is laid out in a binary image. Only fixed-layout,
+// pointer-free types have a description, so anything that serializes
+// can be viewed in place by another process.
+//
+// The hash covers the structure of the type, every capacity, and the size
+// and alignment of every member, so an image written by a different
+// build of the type is rejected instead of misread.
+template<typename Type> struct image_layout
+{
+};
+
+template<typename Type>
+concept has_image_layout = requires { image_layout<Type>::hash; };
+
+template<typename Type>
+  requires(std::is_arithmetic_v<Type> || std::is_enum_v<Type>)
+struct image_layout<Type>
+{
+  static constexpr std::uint64_t hash = [] {
+    if constexpr (std::is_enum_v<Type>) {
+      return hash_combine(hash_bytes("enum"), image_layout<std::underlying_type_t<Type>>::hash);
+    } else if constexpr (std::is_same_v<Type, bool>) {
+      return hash_combine(hash_bytes("bool"), sizeof(Type));
+    } else if constexpr (std::is_floating_point_v<Type>) {
+      return hash_combine(hash_bytes("float"), sizeof(Type));
+    } else {
+      return hash_combine(hash_bytes(std::is_signed_v<Type> ? "signed" : "unsigned"), sizeof(Type));
+    }
+  }();
+};
+
+template<typename Type>
+constexpr std::uint64_t image_layout_node(const std::string_view name, const std::uint64_t inner)
+{
+  return hash_combine(hash_combine(hash_combine(hash_bytes(name), inner), sizeof(Type)), alignof(Type));
+}
+
+template<has_image_layout Contained, std::size_t Capacity>
+struct image_layout<simple_stack_vector<Contained, Capacity>>
+{
+  static constexpr std::uint64_t hash = image_layout_node<simple_stack_vector<Contained, Capacity>>(
+    "simple_stack_vector", hash_combine(image_layout<Contained>::hash, Capacity));
+};
+
+template<has_image_layout Contained, std::size_t Capacity> struct image_layout<std::array<Contained, Capacity>>
+{
+  static constexpr std::uint64_t hash = image_layout_node<std::array<Contained, Capacity>>(
+    "array", hash_combine(image_layout<Contained>::hash, Capacity));
+};
+
+template<has_image_layout CharType, std::size_t Capacity, typename Traits>
+struct image_layout<basic_simple_stack_string<CharType, Capacity, Traits>>
+{
+  static constexpr std::uint64_t hash = image_layout_node<basic_simple_stack_string<CharType, Capacity, Traits>>(
+    "basic_simple_stack_string", hash_combine(image_layout<CharType>::hash, Capacity));
+};
+
+template<has_image_layout First, has_image_layout Second> struct image_layout<pair<First, Second>>
+{
+  static constexpr std::uint64_t hash =
+    image_layout_node<pair<First, Second>>("pair", hash_combine(image_layout<First>::hash, image_layout<Second>::hash));
+};
+
+template<typename Key, typename Value, has_image_layout Container>
+struct image_layout<flat_map_adapter<Key, Value, Container>>
+{
+  static constexpr std::uint64_t hash =
+    image_layout_node<flat_map_adapter<Key, Value, Container>>("flat_map_adapter", image_layout<Container>::hash);
+};
+
+
+template<typename Type>
+concept image_storable = std::is_trivially_copyable_v<Type> && has_image_layout<Type>;
+
+struct image_header
+{
+  static constexpr std::array<char, 8> expected_magic{ 'L', 'T', 'I', 'M', 'A', 'G', 'E', '\0' };
+  static constexpr std::uint32_t current_version = 1;
+  // written in native byte order, so it reads back differently on a
+  // platform with the other endianness
+  static constexpr std::uint32_t native_endian_tag = 0x01020304;// NOLINT Magic Number
+
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t endian_tag;
+  std::uint64_t layout_hash;
+  // where the value starts, from the beginning of the image
+  std::uint64_t offset;
+  std::uint64_t size;
+};
+
+// the value is aligned for its type, relative to the start of the image
+template<typename Type>
+inline constexpr std::size_t image_value_offset = (sizeof(image_header) + alignof(Type) - 1) / alignof(Type)
+                                                  * alignof(Type);
+
+template<image_storable Type> inline constexpr std::size_t image_size = image_value_offset<Type> + sizeof(Type);
+
+
+// The bytes of an image of value: a header followed by the object
+// representation of value itself. Write it to a file and view_image or
+// mapped_image can use it without any parsing.
+//
+// Padding inside Type is copied from value as is. With GCC and Clang it is
+// then cleared, so equal values always give identical images; elsewhere
+// the padding bytes are unspecified, and may hold whatever was in memory.
+template<image_storable Type> [[nodiscard]] std::vector<std::byte> serialize_image(const Type &value)
+{
+  const image_header header{ image_header::expected_magic,
+    image_header::current_version,
+    image_header::native_endian_tag,
+    image_layout<Type>::hash,
+    image_value_offset<Type>,
+    sizeof(Type) };
+
+  // value initialized, so padding in the header and between the header
+  // and value is always zero
+  std::vector<std::byte> result(image_size<Type>);
+  std::memcpy(result.data(), &header, sizeof(header));
+  std::byte *const stored = result.data() + image_value_offset<Type>;
+  std::memcpy(stored, &value, sizeof(Type));
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_clear_padding)
+  // the vector's storage is only aligned for new's default alignment
+  if constexpr (alignof(Type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    __builtin_clear_padding(std::launder(reinterpret_cast<Type *>(stored)));// NOLINT (bytes hold a Type)
+  }
+#endif
+#endif
+
+  return result;
+}
+
+// Checks that bytes holds an image of a Type and returns the value in
+// place, nothing is copied. bytes must outlive the returned reference and
+// the start of bytes must be aligned for Type, as it is for memory from
+// mmap or operator new.
+template<image_storable Type> [[nodiscard]] const Type &view_image(const std::span<const std::byte> bytes)
+{
+  if (bytes.size() < sizeof(image_header)) { throw std::runtime_error("binary image is truncated"); }
+
+  image_header header{};
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if (header.magic != image_header::expected_magic) { throw std::runtime_error("not a binary image"); }
+  if (header.version != image_header::current_version) { throw std::runtime_error("unsupported binary image version"); }
+  if (header.endian_tag != image_header::native_endian_tag) {
+    throw std::runtime_error("binary image was written with a different endianness");
+  }
+  if (header.layout_hash != image_layout<Type>::hash || header.offset != image_value_offset<Type>
+      || header.size != sizeof(Type)) {
+    throw std::runtime_error("binary image holds a different type");
+  }
+  if (bytes.size() < image_size<Type>) { throw std::runtime_error("binary image is truncated"); }
+
+  const auto *const value = bytes.data() + image_value_offset<Type>;
+  if (reinterpret_cast<std::uintptr_t>(value) % alignof(Type) != 0) {// NOLINT (address check)
+    throw std::runtime_error("binary image is not aligned for its type");
+  }
+
+  // Type is trivially copyable, so the bytes already are a Type
+  return *std::launder(reinterpret_cast<const Type *>(value));// NOLINT (viewing the image in place)
+}
+
+
+#if __has_include(<sys/mman.h>)
+
+// A read-only mapping of an image file. Opening it costs the same no
+// matter how large the value is: pages are only read in as they are used.
+template<image_storable Type> struct mapped_image
+{
+  explicit mapped_image(const std::filesystem::path &path)
+  {
+    const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);// NOLINT (vararg)
+    if (file == -1) { throw std::runtime_error("unable to open binary image"); }
+
+    struct stat status = {};
+    if (::fstat(file, &status) == -1 || status.st_size <= 0) {
+      ::close(file);
+      throw std::runtime_error("unable to read binary image");
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    address_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+    // the mapping holds its own reference to the file
+    ::close(file);
+    if (address_ == MAP_FAILED) {// NOLINT (C macro)
+      address_ = nullptr;
+      throw std::runtime_error("unable to map binary image");
+    }
+
+    try {
+      value_ = &view_image<Type>(bytes());
+    } catch (...) {
+      ::munmap(address_, size_);
+      throw;
+    }
+  }
+
+  mapped_image(const mapped_image &) = delete;
+  mapped_image &operator=(const mapped_image &) = delete;
+
+  mapped_image(mapped_image &&other) noexcept
+    : address_{ std::exchange(other.address_, nullptr) }, size_{ std::exchange(other.size_, 0) },
+      value_{ std::exchange(other.value_, nullptr) }
+  {}
+
+  mapped_image &operator=(mapped_image &&other) noexcept
+  {
+    if (this != &other) {
+      unmap();
+      address_ = std::exchange(other.address_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      value_ = std::exchange(other.value_, nullptr);
+    }
+    return *this;
+  }
+
+  ~mapped_image() { unmap(); }
+
+  [[nodiscard]] const Type &operator*() const noexcept { return *value_; }
+  [[nodiscard]] const Type *operator->() const noexcept { return value_; }
+  [[nodiscard]] const Type &value() const noexcept { return *value_; }
+
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+  {
+    return { static_cast<const std::byte *>(address_), size_ };
+  }
+
+private:
+  void unmap() noexcept
+  {
+    if (address_ != nullptr) { ::munmap(address_, size_); }
+  }
+
+  void *address_ = nullptr;
+  std::size_t size_ = 0;
+  const Type *value_ = nullptr;
+};
+
+#endif
+
+}// namespace lefticus::tools
+
+#endif
@@ -0,0 +1,268 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_FORMAT_HPP
+#define LEFTICUS_TOOLS_FORMAT_HPP
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "non_promoting_ints.hpp"
+#include "simple_stack_string.hpp"
+#include "strong_types.hpp"
+
+namespace lefticus::tools {
+
+// A minimal std::format that writes straight into a simple_stack_string
+//  * the format string is checked at compile time, only `{}`, `{{` and `}}`
+//    are understood and the number of `{}` must match the number of arguments
+//  * integers and floating point values go through std::to_chars, integers
+//    also format during constant evaluation, floating point values do not
+//  * int_np and strong_alias are formatted as their underlying value
+//  * other types can be supported with a `format_value(writer, value)`
+//    overload found by ADL
+template<typename... Args> struct basic_stack_format_string
+{
+  template<typename String>
+    requires std::convertible_to<const String &, std::string_view>
+  consteval basic_stack_format_string(const String &str)// NOLINT implicit on purpose, like std::format_string
+    : str_{ str }
+  {
+    if (count_placeholders(str_) != sizeof...(Args)) {
+      throw std::invalid_argument("number of {} in format string does not match number of arguments");
+    }
+  }
+
+  [[nodiscard]] constexpr std::string_view get() const noexcept { return str_; }
+
+private:
+  [[nodiscard]] static consteval std::size_t count_placeholders(const std::string_view str)
+  {
+    std::size_t count = 0;
+    for (std::size_t idx = 0; idx < str.size(); ++idx) {
+      if (str[idx] == '{') {
+        if (idx + 1 == str.size()) { throw std::invalid_argument("unterminated { in format string"); }
+        if (str[idx + 1] == '}') {
+          ++count;
+        } else if (str[idx + 1] != '{') {
+          throw std::invalid_argument("only {} placeholders are supported");
+        }
+        ++idx;
+      } else if (str[idx] == '}') {
+        if (idx + 1 == str.size() || str[idx + 1] != '}') {
+          throw std::invalid_argument("unmatched } in format string");
+        }
+        ++idx;
+      }
+    }
+    return count;
+  }
+
+  std::string_view str_;
+};
+
+// the type_identity keeps the format string out of argument deduction
+template<typename... Args> using stack_format_string = basic_stack_format_string<std::type_identity_t<Args>...>;
+
+
+// Appends to a string, either throwing std::length_error when it is full
+// or silently dropping whatever does not fit
+template<typename String, bool Truncate> struct format_writer
+{
+  constexpr explicit format_writer(String &out) noexcept : out_{ out } {}
+
+  constexpr void write(std::string_view str)
+  {
+    if constexpr (Truncate) {
+      const auto room = out_.capacity() - out_.size();
+      if (str.size() > room) {
+        str = str.substr(0, room);
+        truncated_ = true;
+      }
+    }
+    out_.append(str);
+  }
+
+  constexpr void write(const char c) { write(std::string_view{ &c, 1 }); }
+
+  [[nodiscard]] constexpr bool truncated() const noexcept { return truncated_; }
+
+private:
+  String &out_;
+  bool truncated_ = false;
+};
+
+
+template<typename Writer> constexpr void format_value(Writer &writer, const std::string_view value)
+{
+  writer.write(value);
+}
+
+template<typename Writer> constexpr void format_value(Writer &writer, const char *value)
+{
+  writer.write(std::string_view{ value });
+}
+
+template<typename Writer, typename String>
+  requires(std::convertible_to<const String &, std::string_view> && !std::is_pointer_v<String>)
+constexpr void format_value(Writer &writer, const String &value)
+{
+  writer.write(static_cast<std::string_view>(value));
+}
+
+template<typename Writer> constexpr void format_value(Writer &writer, const char value) { writer.write(value); }
+
+template<typename Writer> constexpr void format_value(Writer &writer, const bool value)
+{
+  writer.write(value ? std::string_view{ "true" } : std::string_view{ "false" });
+}
+
+template<typename Writer, std::integral Integer>
+  requires(!std::same_as<Integer, bool> && !std::same_as<Integer, char>)
+constexpr void format_value(Writer &writer, const Integer value)
+{
+  // digits10 is rounded down, so one more digit and room for a sign
+  constexpr std::size_t buffer_size = std::numeric_limits<Integer>::digits10 + 2;
+  std::array<char, buffer_size> buffer{};
+
+  if (std::is_constant_evaluated()) {
+    // at least unsigned int, so the arithmetic below is never promoted to int
+    using unsigned_type = std::common_type_t<std::make_unsigned_t<Integer>, unsigned int>;
+    bool negative = false;
+    unsigned_type magnitude{};
+    if constexpr (std::is_signed_v<Integer>) {
+      negative = value < 0;
+      // negate in unsigned arithmetic so the smallest value does not overflow
+      magnitude = static_cast<unsigned_type>(value);
+      if (negative) { magnitude = unsigned_type{} - magnitude; }
+    } else {
+      magnitude = value;
+    }
+
+    auto pos = buffer.size();
+    do {
+      buffer[--pos] = static_cast<char>('0' + magnitude % 10);// NOLINT Magic Number
+      magnitude /= 10;// NOLINT Magic Number
+    } while (magnitude != 0);
+    if (negative) { buffer[--pos] = '-'; }
+
+    writer.write(std::string_view{ buffer.data() + pos, buffer.size() - pos });
+  } else {
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    writer.write(std::string_view{ buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data()) });
+  }
+}
+
+// shortest representation that round trips, runtime only
+template<typename Writer, std::floating_point Float> void format_value(Writer &writer, const Float value)
+{
+  std::array<char, 64> buffer{};// NOLINT Magic Number
+  const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  if (result.ec != std::errc{}) { throw std::length_error("floating point value too long to format"); }
+  writer.write(std::string_view{ buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data()) });
+}
+
+template<typename Writer, typename Type> constexpr void format_value(Writer &writer, const int_np<Type> value)
+{
+  format_value(writer, value.get());
+}
+
+template<typename Writer, typename Underlying, typename Tag, auto Validator>
+constexpr void format_value(Writer &writer, const strong_alias<Underlying, Tag, Validator> &value)
+{
+  format_value(writer, value.get());
+}
+
+
+// writes the literal text up to the next {} and returns what follows it
+template<typename Writer> constexpr std::string_view format_literal(Writer &writer, std::string_view fmt)
+{
+  while (!fmt.empty()) {
+    const auto brace = fmt.find_first_of("{}");
+    writer.write(fmt.substr(0, brace));
+    if (brace == std::string_view::npos) { return {}; }
+
+    // the format string was validated, so a brace is always followed by another character
+    if (fmt[brace] == '{' && fmt[brace + 1] == '}') { return fmt.substr(brace + 2); }
+
+    // {{ or }}
+    writer.write(fmt[brace]);
+    fmt.remove_prefix(brace + 2);
+  }
+  return fmt;
+}
+
+template<typename Writer, typename... Args>
+constexpr void vformat_to(Writer &writer, std::string_view fmt, const Args &...args)
+{
+  ((fmt = format_literal(writer, fmt), format_value(writer, args)), ...);
+  format_literal(writer, fmt);
+}
+
+
+// appends to out, throws std::length_error if the result does not fit
+// out is left holding whatever was written before the overflow
+template<std::size_t Capacity, typename... Args>
+constexpr simple_stack_string<Capacity> &
+  format_to(simple_stack_string<Capacity> &out, const stack_format_string<Args...> fmt, const Args &...args)
+{
+  format_writer<simple_stack_string<Capacity>, false> writer{ out };
+  vformat_to(writer, fmt.get(), args...);
+  return out;
+}
+
+// appends as much as fits to out, returns false if anything was dropped
+template<std::size_t Capacity, typename... Args>
+constexpr bool
+  format_to_truncated(simple_stack_string<Capacity> &out, const stack_format_string<Args...> fmt, const Args &...args)
+{
+  format_writer<simple_stack_string<Capacity>, true> writer{ out };
+  vformat_to(writer, fmt.get(), args...);
+  return !writer.truncated();
+}
+
+// throws std::length_error if the result does not fit
+template<std::size_t Capacity, typename... Args>
+[[nodiscard]] constexpr simple_stack_string<Capacity> format_stack(const stack_format_string<Args...> fmt,
+  const Args &...args)
+{
+  simple_stack_string<Capacity> result;
+  format_to(result, fmt, args...);
+  return result;
+}
+
+}// namespace lefticus::tools
+
+#endif
@@ -0,0 +1,322 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_HASH_HPP
+#define LEFTICUS_TOOLS_HASH_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "non_promoting_ints.hpp"
+#include "simple_stack_string.hpp"
+#include "simple_stack_vector.hpp"
+#include "utility.hpp"
+
+namespace lefticus::tools {
+
+// wyhash (final version 4) by Wang Yi, released into the public domain
+//  * gives the same answer at compile time and at runtime
+//  * bytes are always read as little endian, so results do not depend
+//    on the platform either
+//  * at runtime on little endian platforms 8 byte blocks are read with a
+//    single unaligned load
+//  * not a cryptographic hash, do not use it where hash flooding matters
+//    unless the seed is secret
+namespace wyhash {
+  inline constexpr std::uint64_t secret0 = 0x2d358dccaa6c78a5ULL;
+  inline constexpr std::uint64_t secret1 = 0x8bb84b93962eacc9ULL;
+  inline constexpr std::uint64_t secret2 = 0x4b33a62ed433d4a3ULL;
+  inline constexpr std::uint64_t secret3 = 0x4d5a2da51de1aa47ULL;
+
+  // 64x64 -> 128 bit multiply, low half in lhs, high half in rhs
+  constexpr void mum(std::uint64_t &lhs, std::uint64_t &rhs) noexcept
+  {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    const uint128 result = uint128{ lhs } * rhs;
+    lhs = static_cast<std::uint64_t>(result);
+    rhs = static_cast<std::uint64_t>(result >> 64U);// NOLINT Magic Number
+#else
+    constexpr std::uint64_t low_mask = 0xffffffffULL;
+    const std::uint64_t ha = lhs >> 32U;// NOLINT Magic Number
+    const std::uint64_t hb = rhs >> 32U;// NOLINT Magic Number
+    const std::uint64_t la = lhs & low_mask;
+    const std::uint64_t lb = rhs & low_mask;
+    const std::uint64_t rh = ha * hb;
+    const std::uint64_t rm0 = ha * lb;
+    const std::uint64_t rm1 = hb * la;
+    const std::uint64_t rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32U);// NOLINT Magic Number
+    std::uint64_t c = t < rl ? 1U : 0U;
+    const std::uint64_t lo = t + (rm1 << 32U);// NOLINT Magic Number
+    c += lo < t ? 1U : 0U;
+    lhs = lo;
+    rhs = rh + (rm0 >> 32U) + (rm1 >> 32U) + c;// NOLINT Magic Number
+#endif
+  }
+
+  [[nodiscard]] constexpr std::uint64_t mix(std::uint64_t lhs, std::uint64_t rhs) noexcept
+  {
+    mum(lhs, rhs);
+    return lhs ^ rhs;
+  }
+
+  // Reads the bytes of a sequence of characters in little endian order.
+  // Characters wider than a byte contribute all of their bytes.
+  template<typename CharType> struct byte_reader
+  {
+    const CharType *data;
+
+    [[nodiscard]] constexpr std::uint64_t byte(const std::size_t idx) const noexcept
+    {
+      if constexpr (std::is_same_v<CharType, unsigned char>) {
+        return data[idx];
+      } else if constexpr (sizeof(CharType) == 1) {
+        return static_cast<unsigned char>(data[idx]);
+      } else {
+        using unsigned_type = std::make_unsigned_t<CharType>;
+        const auto value = static_cast<std::uint64_t>(static_cast<unsigned_type>(data[idx / sizeof(CharType)]));
+        return (value >> ((idx % sizeof(CharType)) * 8U)) & 0xffU;// NOLINT Magic Number
+      }
+    }
+
+    [[nodiscard]] constexpr std::uint64_t read(const std::size_t idx, const std::size_t count) const noexcept
+    {
+      if constexpr (sizeof(CharType) == 1 && std::endian::native == std::endian::little) {
+        if (!std::is_constant_evaluated()) {
+          std::uint64_t result = 0;
+          std::memcpy(&result, data + idx, count);
+          return result;
+        }
+      }
+
+      std::uint64_t result = 0;
+      for (std::size_t byte_idx = 0; byte_idx < count; ++byte_idx) {
+        result |= byte(idx + byte_idx) << (byte_idx * 8U);// NOLINT Magic Number
+      }
+      return result;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t read8(const std::size_t idx) const noexcept { return read(idx, 8); }
+    [[nodiscard]] constexpr std::uint64_t read4(const std::size_t idx) const noexcept { return read(idx, 4); }
+    [[nodiscard]] constexpr std::uint64_t read3(const std::size_t idx, const std::size_t count) const noexcept
+    {
+      return (byte(idx) << 16U) | (byte(idx + (count >> 1U)) << 8U) | byte(idx + count - 1);// NOLINT Magic Number
+    }
+  };
+
+  template<typename CharType>
+  [[nodiscard]] constexpr std::uint64_t
+    hash(const byte_reader<CharType> input, const std::size_t len, std::uint64_t seed) noexcept
+  {
+    seed ^= mix(seed ^ secret0, secret1);
+
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    std::size_t pos = 0;
+
+    if (len <= 16) {// NOLINT Magic Number
+      if (len >= 4) {
+        const auto offset = (len >> 3U) << 2U;
+        a = (input.read4(0) << 32U) | input.read4(offset);// NOLINT Magic Number
+        b = (input.read4(len - 4) << 32U) | input.read4(len - 4 - offset);// NOLINT Magic Number
+      } else if (len > 0) {
+        a = input.read3(0, len);
+      }
+    } else {
+      std::size_t remaining = len;
+      if (remaining > 48) {// NOLINT Magic Number
+        std::uint64_t see1 = seed;
+        std::uint64_t see2 = seed;
+        do {
+          seed = mix(input.read8(pos) ^ secret1, input.read8(pos + 8) ^ seed);// NOLINT Magic Number
+          see1 = mix(input.read8(pos + 16) ^ secret2, input.read8(pos + 24) ^ see1);// NOLINT Magic Number
+          see2 = mix(input.read8(pos + 32) ^ secret3, input.read8(pos + 40) ^ see2);// NOLINT Magic Number
+          pos += 48;// NOLINT Magic Number
+          remaining -= 48;// NOLINT Magic Number
+        } while (remaining > 48);// NOLINT Magic Number
+        seed ^= see1 ^ see2;
+      }
+      while (remaining > 16) {// NOLINT Magic Number
+        seed = mix(input.read8(pos) ^ secret1, input.read8(pos + 8) ^ seed);// NOLINT Magic Number
+        remaining -= 16;// NOLINT Magic Number
+        pos += 16;// NOLINT Magic Number
+      }
+      a = input.read8(pos + remaining - 16);// NOLINT Magic Number
+      b = input.read8(pos + remaining - 8);// NOLINT Magic Number
+    }
+
+    a ^= secret1;
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ secret0 ^ len, b ^ secret1);
+  }
+}// namespace wyhash
+
+
+[[nodiscard]] constexpr std::uint64_t hash_bytes(const std::string_view data, const std::uint64_t seed = 0) noexcept
+{
+  return wyhash::hash(wyhash::byte_reader<char>{ data.data() }, data.size(), seed);
+}
+
+// hashes the characters as little endian bytes, so the result does not
+// depend on the platform
+template<typename CharType, typename Traits>
+[[nodiscard]] constexpr std::uint64_t hash_string(const std::basic_string_view<CharType, Traits> data,
+  const std::uint64_t seed = 0) noexcept
+{
+  return wyhash::hash(wyhash::byte_reader<CharType>{ data.data() }, data.size() * sizeof(CharType), seed);
+}
+
+[[nodiscard]] constexpr std::uint64_t hash_integer(const std::uint64_t value, const std::uint64_t seed = 0) noexcept
+{
+  return wyhash::mix(value ^ seed ^ wyhash::secret0, wyhash::secret1);
+}
+
+// order dependent combination of two hash values
+[[nodiscard]] constexpr std::uint64_t hash_combine(const std::uint64_t seed, const std::uint64_t value) noexcept
+{
+  return wyhash::mix(seed ^ wyhash::secret2, value ^ wyhash::secret3);
+}
+
+template<typename Type> constexpr bool is_int_np_v = false;
+template<typename Type> constexpr bool is_int_np_v<int_np<Type>> = true;
+
+
+// Transparent hash functor
+//  * strings of any character type hash their characters, so a
+//    basic_simple_stack_string and a std::basic_string_view with the
+//    same contents hash the same
+//  * integers, enums and int_np are mixed, instead of being returned
+//    as-is like most std::hash implementations do
+//  * pairs and ranges combine the hashes of their elements
+//  * everything else falls back to std::hash
+struct hasher
+{
+  using is_transparent = void;
+
+  template<typename Type> [[nodiscard]] constexpr std::size_t operator()(const Type &value) const
+  {
+    // auto keeps the narrowing below dependent, so it is only checked where it is used
+    const auto result = hash64(value);
+    if constexpr (sizeof(std::size_t) < sizeof(std::uint64_t)) {
+      return static_cast<std::size_t>(result ^ (result >> 32U));// NOLINT Magic Number
+    } else {
+      return result;
+    }
+  }
+
+  template<typename Type> [[nodiscard]] static constexpr std::uint64_t hash64(const Type &value)
+  {
+    if constexpr (std::is_convertible_v<const Type &, std::string_view>) {
+      return hash_string(std::string_view{ value });
+    } else if constexpr (requires {
+                           typename Type::traits_type;
+                           std::basic_string_view<typename Type::value_type, typename Type::traits_type>{ value };
+                         }) {
+      return hash_string(std::basic_string_view<typename Type::value_type, typename Type::traits_type>{ value });
+    } else if constexpr (std::is_same_v<Type, std::uint64_t>) {
+      return hash_integer(value);
+    } else if constexpr (std::is_integral_v<Type>) {
+      // sign extends, so equal values of different types hash the same
+      return hash_integer(static_cast<std::uint64_t>(value));
+    } else if constexpr (std::is_enum_v<Type>) {
+      return hash64(static_cast<std::underlying_type_t<Type>>(value));
+    } else if constexpr (is_int_np_v<Type>) {
+      return hash64(value.get());
+    } else if constexpr (requires {
+                           value.first;
+                           value.second;
+                         }) {
+      return hash_combine(hash64(value.first), hash64(value.second));
+    } else if constexpr (requires {
+                           std::begin(value);
+                           std::end(value);
+                         }) {
+      const auto size = std::distance(std::begin(value), std::end(value));
+      std::uint64_t result = hash_integer(static_cast<std::uint64_t>(size));
+      for (const auto &element : value) { result = hash_combine(result, hash64(element)); }
+      return result;
+    } else {
+      const std::uint64_t result = std::hash<Type>{}(value);
+      return result;
+    }
+  }
+};
+
+}// namespace lefticus::tools
+
+
+// these all agree with lefticus::tools::hasher
+namespace std {
+template<typename CharType, std::size_t TotalCapacity, typename Traits>
+struct hash<lefticus::tools::basic_simple_stack_string<CharType, TotalCapacity, Traits>>
+{
+  [[nodiscard]] constexpr std::size_t operator()(
+    const lefticus::tools::basic_simple_stack_string<CharType, TotalCapacity, Traits> &value) const noexcept
+  {
+    return lefticus::tools::hasher{}(value);
+  }
+};
+
+template<typename Contained, std::size_t Capacity>
+struct hash<lefticus::tools::simple_stack_vector<Contained, Capacity>>
+{
+  [[nodiscard]] constexpr std::size_t operator()(
+    const lefticus::tools::simple_stack_vector<Contained, Capacity> &value) const
+  {
+    return lefticus::tools::hasher{}(value);
+  }
+};
+
+template<typename First, typename Second> struct hash<lefticus::tools::pair<First, Second>>
+{
+  [[nodiscard]] constexpr std::size_t operator()(const lefticus::tools::pair<First, Second> &value) const
+  {
+    return lefticus::tools::hasher{}(value);
+  }
+};
+
+template<typename Type> struct hash<lefticus::tools::int_np<Type>>
+{
+  [[nodiscard]] constexpr std::size_t operator()(const lefticus::tools::int_np<Type> value) const noexcept
+  {
+    return lefticus::tools::hasher{}(value);
+  }
+};
+}// namespace std
+
+#endif
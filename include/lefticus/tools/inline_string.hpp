@@ -0,0 +1,488 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_INLINE_STRING_HPP
+#define LEFTICUS_TOOLS_INLINE_STRING_HPP
+
+#include <array>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace lefticus::tools {
+
+// changes from basic_simple_stack_string
+//  * strings longer than InlineCapacity - 1 move to the heap instead of
+//    throwing
+//  * data() and size() are plain member reads, data() points at either
+//    the inline buffer or the heap allocation
+//  * sizeof is the inline buffer plus three words
+//  * capacity() is no longer static
+//  * heap allocations are constexpr, but like std::string they cannot
+//    outlive constant evaluation, see stackify() in static_views.hpp
+//  * requires C++20
+template<typename CharType, std::size_t InlineCapacity, typename Traits = std::char_traits<CharType>>
+struct basic_inline_string
+{
+  using traits_type = Traits;
+  using value_type = CharType;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using data_type = std::array<value_type, InlineCapacity>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using view_type = std::basic_string_view<value_type, traits_type>;
+
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static_assert(InlineCapacity > 0, "room is needed for the null terminator");
+
+  static constexpr auto inline_capacity = InlineCapacity;
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  constexpr basic_inline_string() = default;
+  constexpr basic_inline_string(std::nullptr_t) = delete;
+
+  template<typename Itr> constexpr basic_inline_string(Itr begin, Itr end)
+  {
+    using category = typename std::iterator_traits<Itr>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      reserve(static_cast<size_type>(std::distance(begin, end)));
+    }
+    while (begin != end) {
+      push_back(*begin);
+      ++begin;
+    }
+  }
+
+  constexpr explicit basic_inline_string(std::initializer_list<value_type> data) { append(data.begin(), data.size()); }
+
+  template<std::size_t Size>
+  constexpr explicit basic_inline_string(const value_type (&str)[Size]) : basic_inline_string(view_type(str))
+  {}
+
+  constexpr explicit basic_inline_string(const view_type sv) { append(sv); }
+
+  constexpr basic_inline_string(const basic_inline_string &other) { append(other.view()); }
+
+  constexpr basic_inline_string(basic_inline_string &&other) noexcept { take(other); }
+
+  constexpr basic_inline_string &operator=(const basic_inline_string &other)
+  {
+    if (this != &other) { assign(other.view()); }
+    return *this;
+  }
+
+  constexpr basic_inline_string &operator=(basic_inline_string &&other) noexcept
+  {
+    if (this != &other) {
+      release();
+      take(other);
+    }
+    return *this;
+  }
+
+  constexpr basic_inline_string &operator=(const view_type sv) { return assign(sv); }
+
+  constexpr ~basic_inline_string() { release(); }
+
+  constexpr operator view_type() const noexcept { return view(); }
+
+  [[nodiscard]] constexpr view_type view() const noexcept { return view_type(data_, size_); }
+
+  [[nodiscard]] constexpr value_type *data() noexcept { return data_; }
+  [[nodiscard]] constexpr const value_type *data() const noexcept { return data_; }
+  [[nodiscard]] constexpr const value_type *c_str() const noexcept { return data_; }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return data_; }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return data_; }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data_; }
+
+  [[nodiscard]] constexpr iterator end() noexcept { return data_ + size_; }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return data_ + size_; }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+  [[nodiscard]] constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+  [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+
+  // true while the characters live in the inline buffer
+  [[nodiscard]] constexpr bool is_inline() const noexcept { return data_ == buffer_.data(); }
+
+  constexpr value_type &push_back(const value_type c)
+  {
+    if (size_ == capacity_) { grow(size_ + 1); }
+    data_[size_ + 1] = 0;// null terminator
+    data_[size_] = c;
+    return data_[size_++];
+  }
+
+  [[nodiscard]] constexpr value_type &operator[](const std::size_t idx) noexcept { return data_[idx]; }
+
+  [[nodiscard]] constexpr const value_type &operator[](const std::size_t idx) const noexcept { return data_[idx]; }
+
+  [[nodiscard]] constexpr value_type &at(const std::size_t idx)
+  {
+    if (idx >= size_) { throw std::out_of_range("index past end of inline_string"); }
+    return data_[idx];
+  }
+
+  [[nodiscard]] constexpr const value_type &at(const std::size_t idx) const
+  {
+    if (idx >= size_) { throw std::out_of_range("index past end of inline_string"); }
+    return data_[idx];
+  }
+
+  [[nodiscard]] constexpr value_type &front() noexcept { return data_[0]; }
+  [[nodiscard]] constexpr const value_type &front() const noexcept { return data_[0]; }
+  [[nodiscard]] constexpr value_type &back() noexcept { return data_[size_ - 1]; }
+  [[nodiscard]] constexpr const value_type &back() const noexcept { return data_[size_ - 1]; }
+
+  // As with basic_simple_stack_string, the bulk operations make room once,
+  // copy the characters as a block and write the null terminator once.
+  //
+  // Source characters may point into this string, like they may for
+  // std::basic_string, even though making room can free or shift them.
+
+  constexpr basic_inline_string &append(const value_type *str, const size_type count)
+  {
+    if (points_into(str, count)) {
+      // appending never moves the existing characters, so the offset
+      // survives a reallocation
+      const auto offset = static_cast<size_type>(str - data_);
+      make_room(size_, 0, count);
+      copy_chars(data_ + size_ - count, data_ + offset, count);
+    } else {
+      make_room(size_, 0, count);
+      copy_chars(data_ + size_ - count, str, count);
+    }
+    return *this;
+  }
+
+  constexpr basic_inline_string &append(const view_type sv) { return append(sv.data(), sv.size()); }
+
+  constexpr basic_inline_string &append(const size_type count, const value_type c)
+  {
+    make_room(size_, 0, count);
+    fill_chars(data_ + size_ - count, count, c);
+    return *this;
+  }
+
+  constexpr basic_inline_string &operator+=(const view_type sv) { return append(sv); }
+
+  constexpr basic_inline_string &operator+=(const value_type c)
+  {
+    push_back(c);
+    return *this;
+  }
+
+  constexpr basic_inline_string &assign(const value_type *str, const size_type count)
+  {
+    if (points_into(str, count)) {
+      // a part of this string, so it already fits
+      move_chars(data_, str, count);
+      size_ = count;
+      data_[size_] = 0;
+      return *this;
+    }
+    clear();
+    return append(str, count);
+  }
+
+  constexpr basic_inline_string &assign(const view_type sv) { return assign(sv.data(), sv.size()); }
+
+  constexpr basic_inline_string &assign(const size_type count, const value_type c)
+  {
+    clear();
+    return append(count, c);
+  }
+
+  constexpr basic_inline_string &insert(const size_type pos, const value_type *str, const size_type count)
+  {
+    return replace(pos, 0, str, count);
+  }
+
+  constexpr basic_inline_string &insert(const size_type pos, const view_type sv)
+  {
+    return replace(pos, 0, sv.data(), sv.size());
+  }
+
+  constexpr basic_inline_string &insert(const size_type pos, const size_type count, const value_type c)
+  {
+    make_room(pos, 0, count);
+    fill_chars(data_ + pos, count, c);
+    return *this;
+  }
+
+  constexpr basic_inline_string &erase(const size_type pos = 0, const size_type count = npos)
+  {
+    return replace(pos, count, nullptr, 0);
+  }
+
+  // replaces [pos, pos + count) with [str, str + count2)
+  constexpr basic_inline_string &
+    replace(const size_type pos, const size_type count, const value_type *str, const size_type count2)
+  {
+    if (points_into(str, count2)) {
+      // making room shifts the tail and may reallocate, so copy the source first
+      const basic_inline_string source{ view_type(str, count2) };
+      return replace(pos, count, source.data(), count2);
+    }
+    make_room(pos, count, count2);
+    copy_chars(data_ + pos, str, count2);
+    return *this;
+  }
+
+  constexpr basic_inline_string &replace(const size_type pos, const size_type count, const view_type sv)
+  {
+    return replace(pos, count, sv.data(), sv.size());
+  }
+
+  [[nodiscard]] constexpr size_type find(const value_type c, const size_type pos = 0) const noexcept
+  {
+    return view().find(c, pos);
+  }
+
+  [[nodiscard]] constexpr size_type find(const view_type sv, const size_type pos = 0) const noexcept
+  {
+    return view().find(sv, pos);
+  }
+
+  [[nodiscard]] constexpr size_type rfind(const value_type c, const size_type pos = npos) const noexcept
+  {
+    return view().rfind(c, pos);
+  }
+
+  [[nodiscard]] constexpr size_type rfind(const view_type sv, const size_type pos = npos) const noexcept
+  {
+    return view().rfind(sv, pos);
+  }
+
+  [[nodiscard]] constexpr size_type find_first_of(const value_type c, const size_type pos = 0) const noexcept
+  {
+    return find(c, pos);
+  }
+
+  [[nodiscard]] constexpr size_type find_first_of(const view_type chars, const size_type pos = 0) const noexcept
+  {
+    return view().find_first_of(chars, pos);
+  }
+
+  [[nodiscard]] constexpr bool starts_with(const view_type sv) const noexcept { return view().starts_with(sv); }
+  [[nodiscard]] constexpr bool starts_with(const value_type c) const noexcept { return view().starts_with(c); }
+  [[nodiscard]] constexpr bool ends_with(const view_type sv) const noexcept { return view().ends_with(sv); }
+  [[nodiscard]] constexpr bool ends_with(const value_type c) const noexcept { return view().ends_with(c); }
+
+  [[nodiscard]] constexpr bool contains(const view_type sv) const noexcept { return find(sv) != npos; }
+  [[nodiscard]] constexpr bool contains(const value_type c) const noexcept { return find(c) != npos; }
+
+  [[nodiscard]] constexpr int compare(const view_type sv) const noexcept { return view().compare(sv); }
+
+  // keeps any heap allocation for reuse
+  constexpr void clear() noexcept
+  {
+    size_ = 0;
+    data_[0] = 0;
+  }
+
+  constexpr void reserve(const size_type new_capacity)
+  {
+    if (new_capacity > capacity_) { reallocate(new_capacity); }
+  }
+
+  [[nodiscard]] constexpr size_type capacity() const noexcept { return capacity_; }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static size_type max_size() noexcept
+  {
+    return std::allocator_traits<std::allocator<value_type>>::max_size(std::allocator<value_type>{}) - 1;
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+
+  constexpr void resize(const size_type new_size, const value_type c = value_type{})
+  {
+    if (new_size <= size_) {
+      size_ = new_size;
+      data_[size_] = 0;
+    } else {
+      append(new_size - size_, c);
+    }
+  }
+
+  constexpr void pop_back() noexcept
+  {
+    --size_;
+    data_[size_] = 0;
+  }
+
+  // moves back into the inline buffer if the string fits again
+  constexpr void shrink_to_fit()
+  {
+    if (!is_inline() && size_ != capacity_) { reallocate(size_); }
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const basic_inline_string &lhs,
+    const basic_inline_string &rhs) noexcept
+  {
+    return lhs.view() == rhs.view();
+  }
+
+  // by way of view_type this covers std::basic_string, basic_simple_stack_string,
+  // string literals and views, in either order
+  [[nodiscard]] friend constexpr bool operator==(const basic_inline_string &lhs, const view_type rhs) noexcept
+  {
+    return lhs.view() == rhs;
+  }
+
+private:
+  static constexpr size_type inline_size = InlineCapacity - 1;
+
+  // the old size is kept, new_capacity must be at least size()
+  constexpr void reallocate(const size_type new_capacity)
+  {
+    value_type *new_data = buffer_.data();
+    if (new_capacity > inline_size) {
+      if (new_capacity > max_size()) { throw std::length_error("inline_string would exceed max_size"); }
+      new_data = std::allocator<value_type>{}.allocate(new_capacity + 1);
+    }
+
+    if (new_data != data_) {
+      // +1 for the null terminator
+      copy_chars(new_data, data_, size_ + 1);
+      release();
+      data_ = new_data;
+    }
+    capacity_ = new_capacity > inline_size ? new_capacity : inline_size;
+  }
+
+  // true if [str, str + count) lies within the characters of this string
+  [[nodiscard]] constexpr bool points_into(const value_type *str, const size_type count) const noexcept
+  {
+    if (count == 0) { return false; }
+    if (std::is_constant_evaluated()) {
+      // ordering unrelated pointers is not a constant expression, but comparing them for equality is
+      for (size_type idx = 0; idx < size_; ++idx) {
+        if (str == data_ + idx) { return true; }
+      }
+      return false;
+    }
+    return std::less_equal<>{}(data_, str) && std::less<>{}(str, data_ + size_);
+  }
+
+  // geometric growth, so push_back is amortized constant
+  constexpr void grow(const size_type min_capacity)
+  {
+    const auto doubled = capacity_ > max_size() / 2 ? max_size() : capacity_ * 2;
+    reallocate(min_capacity > doubled ? min_capacity : doubled);
+  }
+
+  constexpr void release() noexcept
+  {
+    if (!is_inline()) { std::allocator<value_type>{}.deallocate(data_, capacity_ + 1); }
+  }
+
+  // leaves other empty and inline, the heap allocation changes hands
+  constexpr void take(basic_inline_string &other) noexcept
+  {
+    if (other.is_inline()) {
+      data_ = buffer_.data();
+      copy_chars(data_, other.data_, other.size_ + 1);
+      capacity_ = inline_size;
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+    }
+    size_ = other.size_;
+
+    other.data_ = other.buffer_.data();
+    other.capacity_ = inline_size;
+    other.clear();
+  }
+
+  static constexpr void copy_chars(value_type *dest, const value_type *src, const size_type count) noexcept
+  {
+    if (count != 0) { traits_type::copy(dest, src, count); }
+  }
+
+  static constexpr void move_chars(value_type *dest, const value_type *src, const size_type count) noexcept
+  {
+    if (count != 0) { traits_type::move(dest, src, count); }
+  }
+
+  static constexpr void fill_chars(value_type *dest, const size_type count, const value_type c) noexcept
+  {
+    if (count != 0) { traits_type::assign(dest, count, c); }
+  }
+
+  // resizes [pos, pos + count) to new_count characters, shifting the tail
+  // the new characters are left for the caller to fill in
+  constexpr void make_room(const size_type pos, size_type count, const size_type new_count)
+  {
+    if (pos > size_) { throw std::out_of_range("position past end of inline_string"); }
+    if (count > size_ - pos) { count = size_ - pos; }
+    if (new_count > count) {
+      if (new_count - count > max_size() - size_) { throw std::length_error("inline_string would exceed max_size"); }
+      if (new_count - count > capacity_ - size_) { grow(size_ + (new_count - count)); }
+    }
+
+    const auto tail_size = size_ - pos - count;
+    move_chars(data_ + pos + new_count, data_ + pos + count, tail_size);
+    size_ = size_ - count + new_count;
+    data_[size_] = 0;
+  }
+
+  // buffer_ comes first so data_ can be initialized from it
+  data_type buffer_{};
+  value_type *data_{ buffer_.data() };
+  size_type size_{};
+  size_type capacity_{ inline_size };
+};
+
+template<typename CharType, std::size_t Size>
+basic_inline_string(const CharType (&)[Size]) -> basic_inline_string<CharType, Size>;
+
+template<std::size_t InlineCapacity> using inline_string = basic_inline_string<char, InlineCapacity>;
+
+}// namespace lefticus::tools
+
+#endif
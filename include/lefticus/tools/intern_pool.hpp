@@ -0,0 +1,206 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_INTERN_POOL_HPP
+#define LEFTICUS_TOOLS_INTERN_POOL_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hash.hpp"
+#include "simple_stack_string.hpp"
+#include "simple_stack_vector.hpp"
+
+namespace lefticus::tools {
+
+// Maps strings to dense ids, 0, 1, 2... in the order they were first seen
+//  * all of the text lives back to back in one TextContainer
+//  * id -> string_view is two reads from the offsets table
+//  * string -> id is an open addressing hash table of ids with linear
+//    probing, the full hash of each string is kept so most mismatches
+//    never touch the text
+//  * if TableContainer can be resized the table doubles to stay at most
+//    3/4 full, otherwise it must be created with a power of 2 size, larger
+//    than the number of strings that will be interned
+//
+// string_views handed out are invalidated if TextContainer reallocates
+template<typename TextContainer, typename OffsetContainer, typename HashContainer, typename TableContainer>
+struct intern_pool_adapter
+{
+  using id_type = std::uint32_t;
+  using size_type = std::size_t;
+
+  static constexpr id_type empty_slot = std::numeric_limits<id_type>::max();
+
+  constexpr intern_pool_adapter()
+  {
+    if constexpr (growable) { table_.resize(initial_table_size); }
+    for (auto &slot : table_) { slot = empty_slot; }
+    offsets_.push_back(id_type{});
+  }
+
+  // interns every string of other in order, so ids are preserved
+  template<typename Text, typename Offset, typename Hash, typename Table>
+  constexpr explicit intern_pool_adapter(const intern_pool_adapter<Text, Offset, Hash, Table> &other)
+    : intern_pool_adapter()
+  {
+    for (id_type id = 0; id < other.size(); ++id) { intern(other[id]); }
+  }
+
+  // returns the id of str, adding it if it has not been seen before
+  constexpr id_type intern(const std::string_view str)
+  {
+    const auto hash = hasher{}(str);
+    auto slot = find_slot(str, hash);
+    if (table_[slot] != empty_slot) { return table_[slot]; }
+
+    if (text_.size() + str.size() > std::numeric_limits<id_type>::max() || size() + 1 >= empty_slot) {
+      throw std::length_error("intern_pool would exceed the range of its ids");
+    }
+
+    // check everything up front, so a failed intern leaves the pool unchanged
+    if (size() == hashes_.max_size()) { throw std::length_error("intern would exceed intern_pool capacity"); }
+
+    if constexpr (growable) {
+      if ((size() + 1) * 4 > table_.size() * 3) {
+        grow();
+        slot = find_slot(str, hash);
+      }
+    } else {
+      // there must always be an empty slot to end the probing
+      if (size() + 2 > table_.size()) { throw std::length_error("intern would exceed static hash table capacity"); }
+    }
+
+    const auto id = static_cast<id_type>(size());
+    text_.append(str);
+    offsets_.push_back(static_cast<id_type>(text_.size()));
+    hashes_.push_back(hash);
+    table_[slot] = id;
+    return id;
+  }
+
+  [[nodiscard]] constexpr std::optional<id_type> find(const std::string_view str) const
+  {
+    const auto id = table_[find_slot(str, hasher{}(str))];
+    if (id == empty_slot) { return std::nullopt; }
+    return id;
+  }
+
+  [[nodiscard]] constexpr bool contains(const std::string_view str) const { return find(str).has_value(); }
+
+  // unchecked
+  [[nodiscard]] constexpr std::string_view operator[](const id_type id) const noexcept
+  {
+    return std::string_view{ text_.data() + offsets_[id], offsets_[id + 1] - offsets_[id] };
+  }
+
+  [[nodiscard]] constexpr std::string_view at(const id_type id) const
+  {
+    if (id >= size()) { throw std::out_of_range("id not in intern_pool"); }
+    return (*this)[id];
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return hashes_.size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return hashes_.empty(); }
+
+  // every interned string, back to back, in id order
+  [[nodiscard]] constexpr std::string_view text() const noexcept
+  {
+    return std::string_view{ text_.data(), text_.size() };
+  }
+
+private:
+  static constexpr bool growable = requires(TableContainer &table) { table.resize(size_type{}); };
+  static constexpr size_type initial_table_size = 16;
+
+  [[nodiscard]] constexpr size_type find_slot(const std::string_view str, const size_type hash) const
+  {
+    const auto mask = table_.size() - 1;
+    for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+      const auto id = table_[slot];
+      if (id == empty_slot || (hashes_[id] == hash && (*this)[id] == str)) { return slot; }
+    }
+  }
+
+  constexpr void grow()
+  {
+    table_.assign(table_.size() * 2, empty_slot);
+    const auto mask = table_.size() - 1;
+    for (id_type id = 0; id < size(); ++id) {
+      auto slot = hashes_[id] & mask;
+      while (table_[slot] != empty_slot) { slot = (slot + 1) & mask; }
+      table_[slot] = id;
+    }
+  }
+
+  TextContainer text_{};
+  // offsets_[id] to offsets_[id + 1] is the text of id
+  OffsetContainer offsets_{};
+  HashContainer hashes_{};
+  TableContainer table_{};
+};
+
+using intern_pool = intern_pool_adapter<std::string,
+  std::vector<std::uint32_t>,
+  std::vector<std::size_t>,
+  std::vector<std::uint32_t>>;
+
+// smallest power of 2 that keeps the table at most half full
+[[nodiscard]] constexpr std::size_t intern_pool_table_size(const std::size_t max_strings) noexcept
+{
+  std::size_t result = 1;
+  while (result < max_strings * 2) { result *= 2; }
+  return result;
+}
+
+// Fixed capacity version, for interning well known names at compile time
+//  * TextCapacity is the total number of characters of all strings
+//  * MaxStrings is the number of distinct strings
+//
+// constexpr auto names = [] {
+//   simple_stack_intern_pool<64, 8> pool;
+//   pool.intern("cpu");
+//   pool.intern("memory");
+//   return pool;
+// }();
+template<std::size_t TextCapacity, std::size_t MaxStrings>
+using simple_stack_intern_pool = intern_pool_adapter<simple_stack_string<TextCapacity + 1>,
+  simple_stack_vector<std::uint32_t, MaxStrings + 1>,
+  simple_stack_vector<std::size_t, MaxStrings>,
+  std::array<std::uint32_t, intern_pool_table_size(MaxStrings)>>;
+
+}// namespace lefticus::tools
+
+#endif
@@ -0,0 +1,405 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_JSON_HPP
+#define LEFTICUS_TOOLS_JSON_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "unicode.hpp"
+
+namespace lefticus::tools {
+
+// Reads JSON directly into the types that describe it, so the same code
+// works at runtime and at compile time. Feeding the result through
+// minimized_stackify gives configuration that is parsed, validated and
+// right-sized before the program ever runs:
+//
+//   using config = flat_map<std::string, flat_map<std::string, std::vector<int>>>;
+//   constexpr auto settings = minimized_stackify<64>([] { return parse_json<config>(source); });
+//
+// where source is a string literal or, with C++26, a char array filled
+// by #embed "config.json".
+//
+// Mapping from JSON to types:
+//  * object: anything with key_type and mapped_type, such as flat_map,
+//    duplicate keys are an error
+//  * array: anything else with push_back, such as std::vector
+//  * string: anything with traits_type, such as std::string, the text
+//    must be valid UTF-8 and \u escapes are written in the encoding of
+//    its character type
+//  * true and false: bool
+//  * number: integral types, which reject fractions and out of range
+//    values, or floating point types, which reject values too large for
+//    them instead of giving infinity
+//  * null: std::optional, which is also filled in by any other value
+//
+// Nesting is bounded by the nesting of the types, so malicious input
+// cannot recurse any deeper than valid input. Any error throws
+// std::invalid_argument, which makes constant evaluation fail with the
+// message in the compiler's diagnostic.
+struct json_reader
+{
+  std::string_view input;
+  std::size_t pos = 0;
+
+  template<typename Type> constexpr void read(Type &value)
+  {
+    skip_whitespace();
+
+    if constexpr (std::is_same_v<Type, bool>) {
+      if (consume("true")) {
+        value = true;
+      } else if (consume("false")) {
+        value = false;
+      } else {
+        throw std::invalid_argument("json: expected true or false");
+      }
+    } else if constexpr (std::is_integral_v<Type>) {
+      value = read_integer<Type>();
+    } else if constexpr (std::is_floating_point_v<Type>) {
+      value = read_floating_point<Type>();
+    } else if constexpr (requires { value.emplace(); value.reset(); *value; }) {
+      if (consume("null")) {
+        value.reset();
+      } else {
+        read(value.emplace());
+      }
+    } else if constexpr (requires { typename Type::traits_type; }) {
+      read_string(value);
+    } else if constexpr (requires {
+                           typename Type::key_type;
+                           typename Type::mapped_type;
+                         }) {
+      read_object(value);
+    } else if constexpr (requires { value.push_back(std::declval<typename Type::value_type>()); }) {
+      read_array(value);
+    } else {
+      static_assert(!std::is_same_v<Type, Type>, "type cannot be read from json");
+    }
+  }
+
+  constexpr void skip_whitespace() noexcept
+  {
+    while (pos < input.size()
+           && (input[pos] == ' ' || input[pos] == '\t' || input[pos] == '\n' || input[pos] == '\r')) {
+      ++pos;
+    }
+  }
+
+  [[nodiscard]] constexpr bool at_end() const noexcept { return pos == input.size(); }
+
+private:
+  [[nodiscard]] constexpr bool consume(const std::string_view token) noexcept
+  {
+    if (!input.substr(pos).starts_with(token)) { return false; }
+    pos += token.size();
+    return true;
+  }
+
+  constexpr void expect(const char c, const char *message)
+  {
+    skip_whitespace();
+    if (pos == input.size() || input[pos] != c) { throw std::invalid_argument(message); }
+    ++pos;
+  }
+
+  [[nodiscard]] constexpr bool is_digit() const noexcept
+  {
+    return pos < input.size() && input[pos] >= '0' && input[pos] <= '9';
+  }
+
+  // the digits of a JSON integer part, no leading zeros allowed
+  constexpr void check_integer_part() const
+  {
+    if (!is_digit()) { throw std::invalid_argument("json: expected a number"); }
+    if (input[pos] == '0' && pos + 1 < input.size() && input[pos + 1] >= '0' && input[pos + 1] <= '9') {
+      throw std::invalid_argument("json: numbers cannot have leading zeros");
+    }
+  }
+
+  template<typename Type> constexpr Type read_integer()
+  {
+    const bool negative = consume("-");
+    if (negative && std::is_unsigned_v<Type>) { throw std::invalid_argument("json: integer out of range"); }
+    check_integer_part();
+
+    // accumulated as a negative number when negative, so min() fits
+    Type result = 0;
+    while (is_digit()) {
+      const auto digit = static_cast<Type>(input[pos++] - '0');
+      if (negative) {
+        if (result < (std::numeric_limits<Type>::min() + digit) / 10) {// NOLINT Magic Number
+          throw std::invalid_argument("json: integer out of range");
+        }
+        result = static_cast<Type>(result * 10 - digit);// NOLINT Magic Number
+      } else {
+        if (result > (std::numeric_limits<Type>::max() - digit) / 10) {// NOLINT Magic Number
+          throw std::invalid_argument("json: integer out of range");
+        }
+        result = static_cast<Type>(result * 10 + digit);// NOLINT Magic Number
+      }
+    }
+
+    if (pos < input.size() && (input[pos] == '.' || input[pos] == 'e' || input[pos] == 'E')) {
+      throw std::invalid_argument("json: expected an integer");
+    }
+    return result;
+  }
+
+  // Exact when the significant digits fit in 53 bits and the exponent is
+  // within 22, as it is for nearly all hand written numbers, otherwise
+  // within a few units in the last place.
+  template<typename Type> constexpr Type read_floating_point()
+  {
+    const bool negative = consume("-");
+    check_integer_part();
+
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    const auto digit = [&]() {
+      const auto value = static_cast<std::uint64_t>(input[pos++] - '0');
+      if (mantissa < (std::numeric_limits<std::uint64_t>::max() - 9) / 10) {// NOLINT Magic Number
+        mantissa = mantissa * 10 + value;// NOLINT Magic Number
+        return 0;
+      }
+      // digits past what fits are dropped, only their position matters
+      return 1;
+    };
+
+    while (is_digit()) { exponent += digit(); }
+    if (consume(".")) {
+      if (!is_digit()) { throw std::invalid_argument("json: expected a digit after ."); }
+      while (is_digit()) { exponent += digit() - 1; }
+    }
+    if (consume("e") || consume("E")) {
+      const bool negative_exponent = consume("-");
+      if (!negative_exponent) { static_cast<void>(consume("+")); }
+      if (!is_digit()) { throw std::invalid_argument("json: expected an exponent"); }
+      int value = 0;
+      while (is_digit()) {
+        // anything this large is 0 or infinity anyway
+        if (value < 100000) { value = value * 10 + (input[pos] - '0'); }// NOLINT Magic Number
+        ++pos;
+      }
+      exponent += negative_exponent ? -value : value;
+    }
+
+    // every power of ten up to 1e22 is exact in a double
+    constexpr auto powers = [] {
+      std::array<double, 23> result{};// NOLINT Magic Number
+      double power = 1;
+      for (auto &value : result) {
+        value = power;
+        power *= 10;// NOLINT Magic Number
+      }
+      return result;
+    }();
+
+    auto result = static_cast<double>(mantissa);
+    for (; exponent > 22; exponent -= 22) { result *= powers[22]; }// NOLINT Magic Number
+    for (; exponent < -22; exponent += 22) { result /= powers[22]; }// NOLINT Magic Number
+    if (exponent >= 0) {
+      result *= powers[static_cast<std::size_t>(exponent)];
+    } else {
+      result /= powers[static_cast<std::size_t>(-exponent)];
+    }
+
+    // too large for Type is an error, rather than infinity
+    if (result > std::numeric_limits<double>::max()) { throw std::invalid_argument("json: number out of range"); }
+    if constexpr (sizeof(Type) < sizeof(double)) {
+      if (result > static_cast<double>(std::numeric_limits<Type>::max())) {
+        throw std::invalid_argument("json: number out of range");
+      }
+    }
+
+    if constexpr (std::is_same_v<Type, double>) {
+      return negative ? -result : result;
+    } else {
+      return static_cast<Type>(negative ? -result : result);
+    }
+  }
+
+  [[nodiscard]] constexpr std::uint32_t read_hex4()
+  {
+    if (input.size() - pos < 4) { throw std::invalid_argument("json: expected 4 hex digits"); }
+    std::uint32_t result = 0;
+    for (int count = 0; count < 4; ++count) {
+      const auto c = input[pos++];
+      result <<= 4U;// NOLINT Magic Number
+      if (c >= '0' && c <= '9') {
+        result |= static_cast<std::uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        result |= static_cast<std::uint32_t>(c - 'a' + 10);// NOLINT Magic Number
+      } else if (c >= 'A' && c <= 'F') {
+        result |= static_cast<std::uint32_t>(c - 'A' + 10);// NOLINT Magic Number
+      } else {
+        throw std::invalid_argument("json: expected 4 hex digits");
+      }
+    }
+    return result;
+  }
+
+  template<typename String> constexpr void read_string(String &value)
+  {
+    using char_type = typename String::value_type;
+
+    expect('"', "json: expected a string");
+    value = String{};
+    while (true) {
+      if (pos == input.size()) { throw std::invalid_argument("json: unterminated string"); }
+      const auto c = input[pos++];
+      if (c == '"') { return; }
+      if (static_cast<unsigned char>(c) < 0x20U) {// NOLINT Magic Number
+        throw std::invalid_argument("json: control character in string");
+      }
+      if (c != '\\') {
+        if (static_cast<unsigned char>(c) < 0x80U) {// NOLINT Magic Number
+          value.push_back(static_cast<char_type>(c));
+          continue;
+        }
+
+        // anything else must be well formed UTF-8, which is copied as is
+        // or written in the string's own encoding
+        --pos;
+        const auto decoded = decode_code_point(input, pos);
+        if (!decoded.valid) { throw std::invalid_argument("json: invalid UTF-8 in string"); }
+        if constexpr (sizeof(char_type) == 1) {
+          for (std::size_t index = 0; index < decoded.length; ++index) {
+            value.push_back(static_cast<char_type>(input[pos + index]));
+          }
+        } else {
+          append_code_point(value, decoded.code_point);
+        }
+        pos += decoded.length;
+        continue;
+      }
+
+      if (pos == input.size()) { throw std::invalid_argument("json: unterminated string"); }
+      switch (input[pos++]) {
+      case '"':
+        value.push_back(static_cast<char_type>('"'));
+        break;
+      case '\\':
+        value.push_back(static_cast<char_type>('\\'));
+        break;
+      case '/':
+        value.push_back(static_cast<char_type>('/'));
+        break;
+      case 'b':
+        value.push_back(static_cast<char_type>('\b'));
+        break;
+      case 'f':
+        value.push_back(static_cast<char_type>('\f'));
+        break;
+      case 'n':
+        value.push_back(static_cast<char_type>('\n'));
+        break;
+      case 'r':
+        value.push_back(static_cast<char_type>('\r'));
+        break;
+      case 't':
+        value.push_back(static_cast<char_type>('\t'));
+        break;
+      case 'u': {
+        auto code_point = read_hex4();
+        if (code_point >= 0xD800U && code_point < 0xDC00U) {// NOLINT Magic Number
+          if (!consume("\\u")) { throw std::invalid_argument("json: unpaired surrogate"); }
+          const auto low = read_hex4();
+          if (low < 0xDC00U || low >= 0xE000U) { throw std::invalid_argument("json: unpaired surrogate"); }// NOLINT
+          code_point = 0x10000U + ((code_point - 0xD800U) << 10U) + (low - 0xDC00U);// NOLINT Magic Number
+        } else if (code_point >= 0xDC00U && code_point < 0xE000U) {// NOLINT Magic Number
+          throw std::invalid_argument("json: unpaired surrogate");
+        }
+        append_code_point(value, static_cast<char32_t>(code_point));
+        break;
+      }
+      default:
+        throw std::invalid_argument("json: invalid escape in string");
+      }
+    }
+  }
+
+  template<typename Map> constexpr void read_object(Map &value)
+  {
+    expect('{', "json: expected an object");
+    value = Map{};
+    skip_whitespace();
+    if (!consume("}")) {
+      do {
+        typename Map::key_type key{};
+        read(key);
+        expect(':', "json: expected : after object key");
+        auto inserted = value.try_emplace(std::move(key));
+        if (!inserted.second) { throw std::invalid_argument("json: duplicate object key"); }
+        read(inserted.first->second);
+        skip_whitespace();
+      } while (consume(","));
+      expect('}', "json: expected , or } in object");
+    }
+  }
+
+  template<typename Sequence> constexpr void read_array(Sequence &value)
+  {
+    expect('[', "json: expected an array");
+    value = Sequence{};
+    skip_whitespace();
+    if (!consume("]")) {
+      do {
+        typename Sequence::value_type element{};
+        read(element);
+        value.push_back(std::move(element));
+        skip_whitespace();
+      } while (consume(","));
+      expect(']', "json: expected , or ] in array");
+    }
+  }
+};
+
+template<typename Type> [[nodiscard]] constexpr Type parse_json(const std::string_view input)
+{
+  Type result{};
+  json_reader reader{ input };
+  reader.read(result);
+  reader.skip_whitespace();
+  if (!reader.at_end()) { throw std::invalid_argument("json: unexpected text after value"); }
+  return result;
+}
+
+}// namespace lefticus::tools
+
+#endif
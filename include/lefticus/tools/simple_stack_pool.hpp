@@ -0,0 +1,241 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_SIMPLE_STACK_POOL_HPP
+#define LEFTICUS_TOOLS_SIMPLE_STACK_POOL_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lefticus::tools {
+
+
+// Fixed capacity object pool
+//  * capacity is fixed at compile-time
+//  * it never allocates
+//  * items must be default constructible, like simple_stack_vector
+//    "construction" is assignment from a newly created object and
+//    "destruction" is assignment from a default constructed one
+//  * acquire and release are O(1), freed slots are threaded into a
+//    free list through the per-slot link array
+//  * objects never move, so pointers and handles stay valid until released
+//  * should be fully usable within constexpr
+template<typename Contained, std::size_t Capacity> struct simple_stack_pool
+{
+  using value_type = Contained;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  // smallest index that can address every slot and still have room for the link markers
+  using index_type = std::conditional_t<(Capacity < std::numeric_limits<std::uint16_t>::max()),
+    std::uint16_t,
+    std::uint32_t>;
+
+  static_assert(std::is_default_constructible_v<Contained>);
+  static_assert(Capacity < std::numeric_limits<std::uint32_t>::max());
+
+  // compact reference to an object in the pool
+  struct handle
+  {
+    index_type index;
+
+    [[nodiscard]] friend constexpr bool operator==(const handle lhs, const handle rhs) noexcept
+    {
+      return lhs.index == rhs.index;
+    }
+    [[nodiscard]] friend constexpr bool operator!=(const handle lhs, const handle rhs) noexcept
+    {
+      return lhs.index != rhs.index;
+    }
+  };
+
+  template<typename Pool, typename Value> struct basic_iterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
+
+    Pool *pool{};
+    index_type index{};
+
+    [[nodiscard]] constexpr reference operator*() const noexcept { return pool->values_[index]; }
+    [[nodiscard]] constexpr pointer operator->() const noexcept { return &pool->values_[index]; }
+
+    constexpr basic_iterator &operator++() noexcept
+    {
+      index = pool->next_live(static_cast<index_type>(index + 1));
+      return *this;
+    }
+
+    [[nodiscard]] constexpr basic_iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++(*this);
+      return result;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const basic_iterator &rhs) const noexcept { return index == rhs.index; }
+    [[nodiscard]] constexpr bool operator!=(const basic_iterator &rhs) const noexcept { return index != rhs.index; }
+  };
+
+  // iteration visits live objects only, in slot order
+  using iterator = basic_iterator<simple_stack_pool, value_type>;
+  using const_iterator = basic_iterator<const simple_stack_pool, const value_type>;
+
+  constexpr simple_stack_pool() = default;
+
+  template<typename... Param> constexpr handle acquire_handle(Param &&...param)
+  {
+    const auto index = free_head_ != end_of_list ? free_head_ : high_water_;
+    if (index == Capacity) { throw std::length_error("acquire would exceed static capacity"); }
+
+    // assign before touching the free list, so a throwing constructor leaves the pool unchanged
+    values_[index] = value_type{ std::forward<Param>(param)... };
+
+    if (index == free_head_) {
+      free_head_ = links_[index];
+    } else {
+      ++high_water_;
+    }
+
+    links_[index] = live_marker;
+    ++size_;
+    return handle{ index };
+  }
+
+  template<typename... Param> constexpr value_type *acquire(Param &&...param)
+  {
+    return &values_[acquire_handle(std::forward<Param>(param)...).index];
+  }
+
+  constexpr void release(const handle object)
+  {
+    if (!is_live(object)) { throw std::invalid_argument("release of object not live in simple_stack_pool"); }
+
+    values_[object.index] = value_type{};
+    links_[object.index] = free_head_;
+    free_head_ = object.index;
+    --size_;
+  }
+
+  constexpr void release(const value_type *object) { release(handle_of(object)); }
+
+  [[nodiscard]] constexpr handle handle_of(const value_type *object) const
+  {
+    if (std::less<const value_type *>{}(object, values_.data())
+        || !std::less<const value_type *>{}(object, values_.data() + high_water_)) {
+      throw std::invalid_argument("object is not owned by simple_stack_pool");
+    }
+
+    return handle{ static_cast<index_type>(object - values_.data()) };
+  }
+
+  [[nodiscard]] constexpr bool is_live(const handle object) const noexcept
+  {
+    return object.index < high_water_ && links_[object.index] == live_marker;
+  }
+
+  [[nodiscard]] constexpr value_type &operator[](const handle object) noexcept { return values_[object.index]; }
+  [[nodiscard]] constexpr const value_type &operator[](const handle object) const noexcept
+  {
+    return values_[object.index];
+  }
+
+  [[nodiscard]] constexpr value_type &at(const handle object)
+  {
+    if (!is_live(object)) { throw std::out_of_range("handle does not refer to a live object in simple_stack_pool"); }
+    return values_[object.index];
+  }
+
+  [[nodiscard]] constexpr const value_type &at(const handle object) const
+  {
+    if (!is_live(object)) { throw std::out_of_range("handle does not refer to a live object in simple_stack_pool"); }
+    return values_[object.index];
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return iterator{ this, next_live(0) }; }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator{ this, next_live(0) }; }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] constexpr iterator end() noexcept { return iterator{ this, high_water_ }; }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator{ this, high_water_ }; }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+  // releases every live object
+  constexpr void clear()
+  {
+    for (index_type index = 0; index < high_water_; ++index) { values_[index] = value_type{}; }
+    high_water_ = 0;
+    free_head_ = end_of_list;
+    size_ = 0;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static size_type capacity() noexcept { return Capacity; }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static size_type max_size() noexcept { return Capacity; }
+
+private:
+  static constexpr auto end_of_list = static_cast<index_type>(Capacity);
+  static constexpr auto live_marker = std::numeric_limits<index_type>::max();
+
+  [[nodiscard]] constexpr index_type next_live(index_type index) const noexcept
+  {
+    while (index < high_water_ && links_[index] != live_marker) { ++index; }
+    return index;
+  }
+
+  // default initializing to make it more C++17 friendly
+  std::array<value_type, Capacity> values_{};
+  // live_marker for live slots, otherwise the next free slot
+  // slots at or past high_water_ have never been used and are not on the list
+  std::array<index_type, Capacity> links_{};
+  index_type free_head_{ end_of_list };
+  index_type high_water_{};
+  size_type size_{};
+};
+
+
+}// namespace lefticus::tools
+
+
+#endif
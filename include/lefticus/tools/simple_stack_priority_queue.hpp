@@ -0,0 +1,187 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_SIMPLE_STACK_PRIORITY_QUEUE_HPP
+#define LEFTICUS_TOOLS_SIMPLE_STACK_PRIORITY_QUEUE_HPP
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "simple_stack_vector.hpp"
+
+namespace lefticus::tools {
+
+
+// changes from std::priority_queue
+//  * capacity is fixed at compile-time, it never allocates
+//  * the heap is Arity-ary, the default of 4 keeps all children of
+//    a node next to each other and halves the depth of the tree
+//  * replace_top() does a pop and a push with a single sift
+//  * push_bounded() gives top-K selection: once full, top() is the
+//    element that gets dropped first
+//  * same requirements on Contained as simple_stack_vector
+//  * should be fully C++17 usable within constexpr
+//
+// As with std::priority_queue, top() is the element for which Compare
+// says every other element is "less", so std::less gives a max-heap.
+template<typename Contained, std::size_t Capacity, typename Compare = std::less<Contained>, std::size_t Arity = 4>
+struct simple_stack_priority_queue
+{
+  using container_type = simple_stack_vector<Contained, Capacity>;
+  using value_compare = Compare;
+  using value_type = Contained;
+  using size_type = typename container_type::size_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using const_iterator = typename container_type::const_iterator;
+
+  static_assert(Arity >= 2);
+
+  constexpr simple_stack_priority_queue() = default;
+  constexpr explicit simple_stack_priority_queue(const Compare &compare) : compare_{ compare } {}
+
+  [[nodiscard]] constexpr const_reference top() const noexcept { return data_[0]; }
+
+  template<typename Value> constexpr void push(Value &&value)
+  {
+    data_.push_back(std::forward<Value>(value));
+    sift_up(data_.size() - 1);
+  }
+
+  template<typename... Param> constexpr void emplace(Param &&...param)
+  {
+    data_.emplace_back(std::forward<Param>(param)...);
+    sift_up(data_.size() - 1);
+  }
+
+  constexpr void pop()
+  {
+    if (data_.size() > 1) { data_[0] = std::move(data_[data_.size() - 1]); }
+    data_.pop_back();
+    sift_down(0);
+  }
+
+  // equivalent to pop() followed by push(value)
+  template<typename Value> constexpr void replace_top(Value &&value)
+  {
+    data_[0] = std::forward<Value>(value);
+    sift_down(0);
+  }
+
+  // Keeps the Capacity elements that would come out of the queue last.
+  // With std::greater, for example, this keeps the Capacity largest
+  // values and top() is the smallest of those.
+  //
+  // returns false if value was dropped
+  template<typename Value> constexpr bool push_bounded(Value &&value)
+  {
+    if (data_.size() < Capacity) {
+      push(std::forward<Value>(value));
+      return true;
+    }
+
+    if constexpr (Capacity == 0) {
+      return false;
+    } else {
+      if (!compare_(value, top())) { return false; }
+      replace_top(std::forward<Value>(value));
+      return true;
+    }
+  }
+
+  // elements in heap order, not sorted order
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return data_.begin(); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data_.cbegin(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return data_.end(); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return data_.cend(); }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return data_.empty(); }
+  [[nodiscard]] constexpr bool full() const noexcept { return data_.size() == Capacity; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return data_.size(); }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static size_type capacity() noexcept { return Capacity; }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static size_type max_size() noexcept { return Capacity; }
+
+  // resets the size to 0, but does not destroy any existing objects
+  constexpr void clear() { data_.clear(); }
+
+private:
+  // moves the hole up instead of swapping, one move per level
+  constexpr void sift_up(size_type index)
+  {
+    value_type value = std::move(data_[index]);
+
+    while (index > 0) {
+      const auto parent = (index - 1) / Arity;
+      if (!compare_(data_[parent], value)) { break; }
+      data_[index] = std::move(data_[parent]);
+      index = parent;
+    }
+
+    data_[index] = std::move(value);
+  }
+
+  constexpr void sift_down(size_type index)
+  {
+    const auto size = data_.size();
+    if (index >= size) { return; }
+
+    value_type value = std::move(data_[index]);
+
+    while (true) {
+      const auto first_child = index * Arity + 1;
+      if (first_child >= size) { break; }
+
+      const auto last_child = first_child + Arity < size ? first_child + Arity : size;
+      auto best_child = first_child;
+      for (auto child = first_child + 1; child < last_child; ++child) {
+        if (compare_(data_[best_child], data_[child])) { best_child = child; }
+      }
+
+      if (!compare_(value, data_[best_child])) { break; }
+      data_[index] = std::move(data_[best_child]);
+      index = best_child;
+    }
+
+    data_[index] = std::move(value);
+  }
+
+  // default initializing to make it more C++17 friendly
+  container_type data_{};
+  Compare compare_{};
+};
+
+
+}// namespace lefticus::tools
+
+
+#endif
@@ -30,11 +30,160 @@ For more information, please refer to <https://unlicense.org>
 #define LEFTICUS_TOOLS_SIMPLE_STACK_STRING_HPP
 
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <stdexcept>
 #include <string_view>
+#include <type_traits>
+
+#if __has_include(<bit>)
+#include <bit>
+#endif
+
+#if defined(__cpp_lib_is_constant_evaluated) && defined(__cpp_lib_bitops) && defined(__cpp_lib_endian)
+#define LEFTICUS_TOOLS_HAS_WORD_SEARCH 1
+#endif
 
 namespace lefticus::tools {
 
+// Set of single byte characters with one bit per possible value, so
+// membership is a shift and a mask instead of a search through the set
+template<typename CharType> struct basic_char_bitmap
+{
+  static_assert(sizeof(CharType) == 1);
+
+  constexpr basic_char_bitmap() = default;
+  constexpr explicit basic_char_bitmap(const std::basic_string_view<CharType> chars) noexcept
+  {
+    for (const auto c : chars) { insert(c); }
+  }
+
+  constexpr void insert(const CharType c) noexcept
+  {
+    const auto value = to_index(c);
+    bits_[value / 64] |= std::uint64_t{ 1 } << (value % 64);// NOLINT Magic Number
+  }
+
+  [[nodiscard]] constexpr bool contains(const CharType c) const noexcept
+  {
+    const auto value = to_index(c);
+    return ((bits_[value / 64] >> (value % 64)) & 1U) != 0;// NOLINT Magic Number
+  }
+
+private:
+  [[nodiscard]] static constexpr std::size_t to_index(const CharType c) noexcept
+  {
+    if constexpr (std::is_same_v<CharType, unsigned char>) {
+      return c;
+    } else {
+      return static_cast<unsigned char>(c);
+    }
+  }
+
+  std::array<std::uint64_t, 4> bits_{};
+};
+
+#ifdef LEFTICUS_TOOLS_HAS_WORD_SEARCH
+// Searches through single byte characters 8 at a time, using only integer
+// operations on 64 bit words. Runtime only, the constexpr callers fall back
+// to their plain loops during constant evaluation.
+struct word_search
+{
+  // use the word search only on little endian platforms, where the first
+  // character in memory is the lowest byte of the word
+  static constexpr bool enabled = std::endian::native == std::endian::little;
+
+  static constexpr std::uint64_t low_bits = 0x0101010101010101ULL;
+  static constexpr std::uint64_t low_seven_bits = 0x7f7f7f7f7f7f7f7fULL;
+  static constexpr std::uint64_t high_bits = 0x8080808080808080ULL;
+
+  // the high bit of each byte of word that is zero, and nothing else
+  [[nodiscard]] static constexpr std::uint64_t zero_bytes(const std::uint64_t word) noexcept
+  {
+    return ~(((word & low_seven_bits) + low_seven_bits) | word | low_seven_bits);
+  }
+
+  // cheaper than zero_bytes, and exact up to the first zero byte, but a
+  // borrow can set the high bit of bytes after it, so it only finds the
+  // lowest zero byte
+  [[nodiscard]] static constexpr std::uint64_t first_zero_byte(const std::uint64_t word) noexcept
+  {
+    return (word - low_bits) & ~word & high_bits;
+  }
+
+  template<typename CharType> [[nodiscard]] static std::uint64_t load(const CharType *data) noexcept
+  {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+  }
+
+  template<typename CharType> [[nodiscard]] static constexpr std::uint64_t broadcast(const CharType c) noexcept
+  {
+    return low_bits * static_cast<unsigned char>(c);
+  }
+
+  // the index of the last c in [data, data + count), or count
+  template<typename CharType>
+  [[nodiscard]] static std::size_t find_last(const CharType *data, std::size_t count, const CharType c) noexcept
+  {
+    const auto pattern = broadcast(c);
+    const auto not_found = count;
+    while (count >= sizeof(std::uint64_t)) {
+      count -= sizeof(std::uint64_t);
+      const auto matches = zero_bytes(load(data + count) ^ pattern);
+      if (matches != 0) { return count + (63U - static_cast<unsigned>(std::countl_zero(matches))) / 8U; }// NOLINT
+    }
+    while (count > 0) {
+      --count;
+      if (data[count] == c) { return count; }
+    }
+    return not_found;
+  }
+
+  // the index of the first character in [data, data + count) that is any
+  // of chars, or count
+  template<typename CharType, std::size_t Size>
+  [[nodiscard]] static std::size_t find_any(const CharType *data,
+    const std::size_t count,
+    const std::array<CharType, Size> &chars) noexcept
+  {
+    std::array<std::uint64_t, Size> patterns{};
+    for (std::size_t idx = 0; idx < Size; ++idx) { patterns[idx] = broadcast(chars[idx]); }
+
+    std::size_t pos = 0;
+    for (; pos + sizeof(std::uint64_t) <= count; pos += sizeof(std::uint64_t)) {
+      const auto word = load(data + pos);
+      std::uint64_t matches = 0;
+      // the lowest bit of each is exact, so the lowest bit of their union is too
+      for (const auto pattern : patterns) { matches |= first_zero_byte(word ^ pattern); }
+      if (matches != 0) { return pos + static_cast<std::size_t>(std::countr_zero(matches)) / 8U; }// NOLINT
+    }
+    for (; pos < count; ++pos) {
+      for (const auto c : chars) {
+        if (data[pos] == c) { return pos; }
+      }
+    }
+    return count;
+  }
+};
+#endif
+
+template<typename CharType, std::size_t TotalCapacity, typename LHS, typename RHS>
+struct basic_simple_stack_string_concat;
+
+template<typename Type> struct is_basic_simple_stack_string_concat : std::false_type
+{
+};
+
+template<typename CharType, std::size_t TotalCapacity, typename LHS, typename RHS>
+struct is_basic_simple_stack_string_concat<basic_simple_stack_string_concat<CharType, TotalCapacity, LHS, RHS>>
+  : std::true_type
+{
+};
+
 template<typename CharType, std::size_t TotalCapacity, typename Traits = std::char_traits<CharType>>
 struct basic_simple_stack_string
 {
@@ -52,22 +201,34 @@ struct basic_simple_stack_string
   using const_reverse_iterator = typename data_type::const_reverse_iterator;
 
   static constexpr auto total_capacity = TotalCapacity;
+  static constexpr size_type npos = static_cast<size_type>(-1);
 
   constexpr basic_simple_stack_string() = default;
   constexpr basic_simple_stack_string(std::nullptr_t) = delete;
 
   template<typename Itr> constexpr basic_simple_stack_string(Itr begin, Itr end)
   {
-    while (begin != end) {
-      push_back(*begin);
-      ++begin;
+    using category = typename std::iterator_traits<Itr>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      // we can know the size up front, so check capacity once
+      const auto count = static_cast<size_type>(std::distance(begin, end));
+      if (count > capacity()) { throw std::length_error("construction would exceed static capacity"); }
+      while (begin != end) {
+        data_[size_++] = *begin;
+        ++begin;
+      }
+      data_[size_] = 0;
+    } else {
+      while (begin != end) {
+        push_back(*begin);
+        ++begin;
+      }
     }
   }
+
   constexpr explicit basic_simple_stack_string(std::initializer_list<value_type> data)
   {
-    for (const auto &c : data) {
-      push_back(c);// push_back is very cheap and this is simple
-    }
+    append(data.begin(), data.size());
   }
 
   template<std::size_t Size>
@@ -77,9 +238,24 @@ struct basic_simple_stack_string
     static_assert(Size <= TotalCapacity);
   }
 
-  constexpr explicit basic_simple_stack_string(const std::basic_string_view<value_type> sv)
+  constexpr explicit basic_simple_stack_string(const std::basic_string_view<value_type> sv) { append(sv); }
+
+  // From the result of operator+, every piece is copied straight into
+  // this string, and the capacities guarantee that it fits.
+  // Implicit, so operator+ can be used like it is for std::string.
+  // cppcheck-suppress noExplicitConstructor
+  template<std::size_t ConcatCapacity,
+    typename LHS,
+    typename RHS,
+    typename = std::enable_if_t<(ConcatCapacity <= TotalCapacity)>>
+  constexpr basic_simple_stack_string(// NOLINT (implicit)
+    const basic_simple_stack_string_concat<value_type, ConcatCapacity, LHS, RHS> &concat)
   {
-    for (const auto c : sv) { push_back(c); }
+    concat.for_each_piece([this](const value_type *str, const size_type count) {
+      copy_chars(data_.data() + size_, str, count);
+      size_ += count;
+    });
+    data_[size_] = 0;
   }
 
 
@@ -88,12 +264,7 @@ struct basic_simple_stack_string
     return std::basic_string_view<value_type>(data(), size());
   }
 
-  constexpr basic_simple_stack_string operator=(const std::basic_string_view<value_type> sv)
-  {
-    clear();
-    for (const auto c : sv) { push_back(c); }
-    return *this;
-  }
+  constexpr basic_simple_stack_string &operator=(const std::basic_string_view<value_type> sv) { return assign(sv); }
 
   [[nodiscard]] constexpr value_type *data() { return data_.data(); }
   [[nodiscard]] constexpr const value_type *data() const { return data_.data(); }
@@ -136,7 +307,7 @@ struct basic_simple_stack_string
 
   constexpr value_type &push_back(const value_type c)
   {
-    if (size_ - 1 == TotalCapacity) { throw std::length_error("push_back would exceed static capacity"); }
+    if (size_ == capacity()) { throw std::length_error("push_back would exceed static capacity"); }
     data_[size_ + 1] = 0;// null terminator
     data_[size_] = c;
     return data_[size_++];
@@ -158,15 +329,245 @@ struct basic_simple_stack_string
     return data_[idx];
   }
 
-  constexpr basic_simple_stack_string &operator+=(const std::string_view sv)
+  // All of the bulk operations check capacity once, copy the characters
+  // as a block and write the null terminator once.
+
+  constexpr basic_simple_stack_string &append(const value_type *str, const size_type count)
   {
-    for (const auto c : sv) { push_back(c); }
+    if (count > capacity() - size_) { throw std::length_error("append would exceed static capacity"); }
+    copy_chars(data_.data() + size_, str, count);
+    size_ += count;
+    data_[size_] = 0;
+    return *this;
+  }
 
+  constexpr basic_simple_stack_string &append(const std::basic_string_view<value_type> sv)
+  {
+    return append(sv.data(), sv.size());
+  }
+
+  constexpr basic_simple_stack_string &append(const size_type count, const value_type c)
+  {
+    if (count > capacity() - size_) { throw std::length_error("append would exceed static capacity"); }
+    fill_chars(data_.data() + size_, count, c);
+    size_ += count;
+    data_[size_] = 0;
+    return *this;
+  }
+
+  constexpr basic_simple_stack_string &operator+=(const std::basic_string_view<value_type> sv) { return append(sv); }
+
+  constexpr basic_simple_stack_string &operator+=(const value_type c)
+  {
+    push_back(c);
     return *this;
   }
 
+  constexpr basic_simple_stack_string &assign(const value_type *str, const size_type count)
+  {
+    if (points_into(str, count)) {
+      // a part of this string, so it already fits
+      move_chars(data_.data(), str, count);
+      size_ = count;
+      data_[size_] = 0;
+      return *this;
+    }
+    clear();
+    return append(str, count);
+  }
+
+  constexpr basic_simple_stack_string &assign(const std::basic_string_view<value_type> sv)
+  {
+    return assign(sv.data(), sv.size());
+  }
+
+  constexpr basic_simple_stack_string &assign(const size_type count, const value_type c)
+  {
+    clear();
+    return append(count, c);
+  }
+
+  constexpr basic_simple_stack_string &insert(const size_type pos, const value_type *str, const size_type count)
+  {
+    return replace(pos, 0, str, count);
+  }
+
+  constexpr basic_simple_stack_string &insert(const size_type pos, const std::basic_string_view<value_type> sv)
+  {
+    return replace(pos, 0, sv.data(), sv.size());
+  }
+
+  constexpr basic_simple_stack_string &insert(const size_type pos, const size_type count, const value_type c)
+  {
+    make_room(pos, 0, count);
+    fill_chars(data_.data() + pos, count, c);
+    return *this;
+  }
+
+  constexpr basic_simple_stack_string &erase(const size_type pos = 0, const size_type count = npos)
+  {
+    return replace(pos, count, nullptr, 0);
+  }
+
+  // replaces [pos, pos + count) with [str, str + count2)
+  constexpr basic_simple_stack_string &
+    replace(const size_type pos, const size_type count, const value_type *str, const size_type count2)
+  {
+    if (points_into(str, count2)) {
+      // making room shifts the tail, so copy the source first
+      const basic_simple_stack_string source{ std::basic_string_view<value_type>(str, count2) };
+      return replace(pos, count, source.data(), count2);
+    }
+    make_room(pos, count, count2);
+    copy_chars(data_.data() + pos, str, count2);
+    return *this;
+  }
+
+  constexpr basic_simple_stack_string &
+    replace(const size_type pos, const size_type count, const std::basic_string_view<value_type> sv)
+  {
+    return replace(pos, count, sv.data(), sv.size());
+  }
+
+  // The searches go through traits_type, which for the standard
+  // character types is memchr/memcmp (or the wide equivalents) at
+  // runtime, and a plain loop during constant evaluation.
+
+  [[nodiscard]] constexpr size_type find(const value_type c, const size_type pos = 0) const noexcept
+  {
+    if (pos >= size_) { return npos; }
+    return to_index(traits_type::find(data_.data() + pos, size_ - pos, c));
+  }
+
+  [[nodiscard]] constexpr size_type find(const std::basic_string_view<value_type> sv,
+    const size_type pos = 0) const noexcept
+  {
+    if (pos > size_ || sv.size() > size_ - pos) { return npos; }
+    if (sv.empty()) { return pos; }
+
+    // scan for the first character, then compare the rest
+    const value_type *first = data_.data() + pos;
+    const value_type *const last = data_.data() + (size_ - sv.size() + 1);
+    while (first != last) {
+      first = traits_type::find(first, static_cast<size_type>(last - first), sv[0]);
+      if (first == nullptr) { return npos; }
+      if (traits_type::compare(first + 1, sv.data() + 1, sv.size() - 1) == 0) { return to_index(first); }
+      ++first;
+    }
+    return npos;
+  }
+
+  [[nodiscard]] constexpr size_type rfind(const value_type c, const size_type pos = npos) const noexcept
+  {
+    if (size_ == 0) { return npos; }
+#ifdef LEFTICUS_TOOLS_HAS_WORD_SEARCH
+    if constexpr (use_word_search) {
+      if (!std::is_constant_evaluated()) {
+        const auto count = (pos < size_ ? pos : size_ - 1) + 1;
+        const auto found = word_search::find_last(data_.data(), count, c);
+        return found == count ? npos : found;
+      }
+    }
+#endif
+    for (size_type idx = (pos < size_ ? pos : size_ - 1) + 1; idx > 0; --idx) {
+      if (traits_type::eq(data_[idx - 1], c)) { return idx - 1; }
+    }
+    return npos;
+  }
+
+  [[nodiscard]] constexpr size_type rfind(const std::basic_string_view<value_type> sv,
+    const size_type pos = npos) const noexcept
+  {
+    if (sv.size() > size_) { return npos; }
+    const auto last_start = size_ - sv.size();
+    for (size_type idx = (pos < last_start ? pos : last_start) + 1; idx > 0; --idx) {
+      if (traits_type::compare(data_.data() + idx - 1, sv.data(), sv.size()) == 0) { return idx - 1; }
+    }
+    return npos;
+  }
+
+  [[nodiscard]] constexpr size_type find_first_of(const value_type c, const size_type pos = 0) const noexcept
+  {
+    return find(c, pos);
+  }
+
+  [[nodiscard]] constexpr size_type find_first_of(const std::basic_string_view<value_type> chars,
+    const size_type pos = 0) const noexcept
+  {
+    if (chars.size() == 1) { return find(chars[0], pos); }
+    if (pos >= size_) { return npos; }
+
+#ifdef LEFTICUS_TOOLS_HAS_WORD_SEARCH
+    // a few characters, such as delimiters, are quicker to check for 8 at
+    // a time than to look up one by one in a bitmap
+    if constexpr (use_word_search) {
+      if (!std::is_constant_evaluated() && chars.size() >= 2 && chars.size() <= 3) {
+        const auto *const first = data_.data() + pos;
+        const auto count = size_ - pos;
+        const auto found = chars.size() == 2
+                             ? word_search::find_any(first, count, std::array{ chars[0], chars[1] })
+                             : word_search::find_any(first, count, std::array{ chars[0], chars[1], chars[2] });
+        return found == count ? npos : pos + found;
+      }
+    }
+#endif
+
+    if constexpr (sizeof(value_type) == 1) {
+      const basic_char_bitmap<value_type> set{ chars };
+      for (size_type idx = pos; idx < size_; ++idx) {
+        if (set.contains(data_[idx])) { return idx; }
+      }
+    } else {
+      for (size_type idx = pos; idx < size_; ++idx) {
+        if (traits_type::find(chars.data(), chars.size(), data_[idx]) != nullptr) { return idx; }
+      }
+    }
+    return npos;
+  }
+
+  [[nodiscard]] constexpr bool starts_with(const std::basic_string_view<value_type> sv) const noexcept
+  {
+    return sv.size() <= size_ && traits_type::compare(data_.data(), sv.data(), sv.size()) == 0;
+  }
+
+  [[nodiscard]] constexpr bool starts_with(const value_type c) const noexcept
+  {
+    return size_ != 0 && traits_type::eq(data_[0], c);
+  }
+
+  [[nodiscard]] constexpr bool ends_with(const std::basic_string_view<value_type> sv) const noexcept
+  {
+    return sv.size() <= size_ && traits_type::compare(data_.data() + (size_ - sv.size()), sv.data(), sv.size()) == 0;
+  }
+
+  [[nodiscard]] constexpr bool ends_with(const value_type c) const noexcept
+  {
+    return size_ != 0 && traits_type::eq(data_[size_ - 1], c);
+  }
+
+  [[nodiscard]] constexpr bool contains(const std::basic_string_view<value_type> sv) const noexcept
+  {
+    return find(sv) != npos;
+  }
+
+  [[nodiscard]] constexpr bool contains(const value_type c) const noexcept { return find(c) != npos; }
+
+  // same ordering as std::basic_string_view::compare
+  [[nodiscard]] constexpr int compare(const std::basic_string_view<value_type> sv) const noexcept
+  {
+    const auto common = size_ < sv.size() ? size_ : sv.size();
+    const auto result = traits_type::compare(data_.data(), sv.data(), common);
+    if (result != 0) { return result; }
+    if (size_ == sv.size()) { return 0; }
+    return size_ < sv.size() ? -1 : 1;
+  }
+
   // resets the size to 0, but does not destroy any existing objects
-  constexpr void clear() { size_ = 0; }
+  constexpr void clear()
+  {
+    size_ = 0;
+    data_[0] = 0;
+  }
 
 
   // cppcheck-suppress functionStatic
@@ -190,7 +591,7 @@ struct basic_simple_stack_string
     if (new_size <= size_) {
       size_ = new_size;
     } else {
-      if (new_size > TotalCapacity) {
+      if (new_size > capacity()) {
         throw std::length_error("resize would exceed static capacity");
       } else {
         auto old_end = end();
@@ -220,6 +621,82 @@ struct basic_simple_stack_string
 
 
 private:
+#ifdef LEFTICUS_TOOLS_HAS_WORD_SEARCH
+  // only plain characters, other traits may not compare byte for byte
+  static constexpr bool use_word_search =
+    sizeof(value_type) == 1 && word_search::enabled && std::is_same_v<traits_type, std::char_traits<value_type>>;
+#endif
+
+  [[nodiscard]] constexpr size_type to_index(const value_type *ptr) const noexcept
+  {
+    return ptr == nullptr ? npos : static_cast<size_type>(ptr - data_.data());
+  }
+
+  // true if [str, str + count) lies within the characters of this string
+  [[nodiscard]] constexpr bool points_into(const value_type *str, const size_type count) const noexcept
+  {
+    if (count == 0) { return false; }
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+      return std::less_equal<>{}(data_.data(), str) && std::less<>{}(str, data_.data() + size_);
+    }
+#endif
+    // ordering unrelated pointers is not a constant expression, but comparing them for equality is
+    for (size_type idx = 0; idx < size_; ++idx) {
+      if (str == data_.data() + idx) { return true; }
+    }
+    return false;
+  }
+
+  // char_traits::copy/move/assign are only constexpr as of C++20
+  static constexpr void copy_chars(value_type *dest, const value_type *src, const size_type count)
+  {
+#if defined(__cpp_lib_constexpr_char_traits) && __cpp_lib_constexpr_char_traits >= 201811L
+    if (count != 0) { traits_type::copy(dest, src, count); }
+#else
+    for (size_type idx = 0; idx < count; ++idx) { dest[idx] = src[idx]; }
+#endif
+  }
+
+  // ranges may overlap
+  static constexpr void move_chars(value_type *dest, const value_type *src, const size_type count)
+  {
+#if defined(__cpp_lib_constexpr_char_traits) && __cpp_lib_constexpr_char_traits >= 201811L
+    if (count != 0) { traits_type::move(dest, src, count); }
+#else
+    if (dest < src) {
+      for (size_type idx = 0; idx < count; ++idx) { dest[idx] = src[idx]; }
+    } else {
+      for (size_type idx = count; idx > 0; --idx) { dest[idx - 1] = src[idx - 1]; }
+    }
+#endif
+  }
+
+  static constexpr void fill_chars(value_type *dest, const size_type count, const value_type c)
+  {
+#if defined(__cpp_lib_constexpr_char_traits) && __cpp_lib_constexpr_char_traits >= 201811L
+    if (count != 0) { traits_type::assign(dest, count, c); }
+#else
+    for (size_type idx = 0; idx < count; ++idx) { dest[idx] = c; }
+#endif
+  }
+
+  // resizes [pos, pos + count) to new_count characters, shifting the tail
+  // the new characters are left for the caller to fill in
+  constexpr void make_room(const size_type pos, size_type count, const size_type new_count)
+  {
+    if (pos > size_) { throw std::out_of_range("position past end of stack_string"); }
+    if (count > size_ - pos) { count = size_ - pos; }
+    if (new_count > count && new_count - count > capacity() - size_) {
+      throw std::length_error("operation would exceed static capacity");
+    }
+
+    const auto tail_size = size_ - pos - count;
+    move_chars(data_.data() + pos + new_count, data_.data() + pos + count, tail_size);
+    size_ = size_ - count + new_count;
+    data_[size_] = 0;
+  }
+
   // default initializing to make it more C++17 friendly
   data_type data_{};
   size_type size_{};
@@ -257,6 +734,13 @@ template<typename CharType, std::size_t Size>
 }
 
 
+template<typename CharType, std::size_t LHSSize, std::size_t RHSSize>
+[[nodiscard]] constexpr bool operator==(const basic_simple_stack_string<CharType, LHSSize> &lhs,
+  const basic_simple_stack_string<CharType, RHSSize> &rhs) noexcept
+{
+  return static_cast<std::basic_string_view<CharType>>(lhs) == static_cast<std::basic_string_view<CharType>>(rhs);
+}
+
 template<typename CharType, std::size_t Size>
 [[nodiscard]] constexpr bool operator==(const basic_simple_stack_string<CharType, Size> &lhs,
   const std::basic_string<CharType> &rhs) noexcept
@@ -272,32 +756,171 @@ template<typename CharType, std::size_t Size>
 }
 
 
-template<typename CharType, std::size_t LHSSize, std::size_t RHSSize>
-[[nodiscard]] constexpr basic_simple_stack_string<CharType, LHSSize + RHSSize - 1>
-  operator+(const basic_simple_stack_string<CharType, LHSSize> &lhs, const CharType (&rhs)[RHSSize])
+// Describes what can appear on either side of operator+
+//  * a basic_simple_stack_string or concatenation: lvalues are referred to,
+//    rvalues are moved into the expression
+//  * a character array: viewed as a string literal
+template<typename Type, typename Operand> struct simple_stack_string_concat_operand
 {
-  basic_simple_stack_string<CharType, LHSSize + RHSSize - 1> result{ lhs };
-  result += rhs;
-  return result;
-}
+  static constexpr bool is_operand = false;
+};
 
-template<typename CharType, std::size_t LHSSize, std::size_t RHSSize>
-[[nodiscard]] constexpr basic_simple_stack_string<CharType, LHSSize + RHSSize - 1>
-  operator+(const CharType (&lhs)[LHSSize], const basic_simple_stack_string<CharType, RHSSize> &rhs)
+template<typename CharType, std::size_t TotalCapacity, typename Operand>
+struct simple_stack_string_concat_operand<basic_simple_stack_string<CharType, TotalCapacity>, Operand>
 {
-  basic_simple_stack_string<CharType, LHSSize + RHSSize - 1> result{ lhs };
-  result += rhs;
-  return result;
-}
+  static constexpr bool is_operand = true;
+  using value_type = CharType;
+  static constexpr std::size_t total_capacity = TotalCapacity;
+  using storage_type = std::conditional_t<std::is_lvalue_reference_v<Operand>,
+    const basic_simple_stack_string<CharType, TotalCapacity> &,
+    basic_simple_stack_string<CharType, TotalCapacity>>;
+};
 
-template<typename CharType, std::size_t LHSSize, std::size_t RHSSize>
-[[nodiscard]] constexpr basic_simple_stack_string<CharType, LHSSize + RHSSize - 1> operator+(
-  const basic_simple_stack_string<CharType, LHSSize> &lhs,
-  const basic_simple_stack_string<CharType, RHSSize> &rhs)
+template<typename CharType, std::size_t TotalCapacity, typename LHS, typename RHS, typename Operand>
+struct simple_stack_string_concat_operand<basic_simple_stack_string_concat<CharType, TotalCapacity, LHS, RHS>,
+  Operand>
+{
+  static constexpr bool is_operand = true;
+  using value_type = CharType;
+  static constexpr std::size_t total_capacity = TotalCapacity;
+  using storage_type = std::conditional_t<std::is_lvalue_reference_v<Operand>,
+    const basic_simple_stack_string_concat<CharType, TotalCapacity, LHS, RHS> &,
+    basic_simple_stack_string_concat<CharType, TotalCapacity, LHS, RHS>>;
+};
+
+template<typename CharType, std::size_t Size, typename Operand>
+struct simple_stack_string_concat_operand<CharType[Size], Operand>
+{
+  static constexpr bool is_operand = true;
+  using value_type = CharType;
+  static constexpr std::size_t total_capacity = Size;
+  using storage_type = std::basic_string_view<CharType>;
+};
+
+template<typename Operand>
+using simple_stack_string_concat_operand_t =
+  simple_stack_string_concat_operand<std::remove_cv_t<std::remove_reference_t<Operand>>, Operand>;
+
+
+// Lazy result of operator+ on basic_simple_stack_string
+//  * nothing is copied until it is converted to a basic_simple_stack_string,
+//    then every piece is written once, straight into the final buffer
+//  * a + b + c + d builds a tree of these, with a total_capacity that is
+//    the sum of the capacities of all of the pieces
+//  * lvalue operands are held by reference, so an expression must not
+//    outlive them, convert it to a string instead of keeping it with auto
+//  * compares equal to any string with the same characters, without
+//    copying them; it has no storage of its own, so it does not convert
+//    to a std::basic_string_view, use str() for that
+//
+// basic_simple_stack_string result = a + b + c;// capacity deduced
+template<typename CharType, std::size_t TotalCapacity, typename LHS, typename RHS>
+struct [[nodiscard]] basic_simple_stack_string_concat
+{
+  using value_type = CharType;
+  using size_type = std::size_t;
+  static constexpr auto total_capacity = TotalCapacity;
+
+  template<typename LHSParam, typename RHSParam>
+  constexpr basic_simple_stack_string_concat(LHSParam &&lhs, RHSParam &&rhs)
+    : lhs_(std::forward<LHSParam>(lhs)), rhs_(std::forward<RHSParam>(rhs))
+  {}
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return lhs_.size() + rhs_.size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static size_type capacity() noexcept { return TotalCapacity - 1; }
+
+  // calls callable(const value_type *, size_type) for each piece, in order
+  template<typename Callable> constexpr void for_each_piece(Callable &&callable) const
+  {
+    visit_piece(lhs_, callable);
+    visit_piece(rhs_, callable);
+  }
+
+  [[nodiscard]] constexpr basic_simple_stack_string<CharType, TotalCapacity> str() const { return *this; }
+
+  // string literals, basic_simple_stack_string and std::basic_string all
+  // convert to the std::basic_string_view, so this covers them, in either order
+  [[nodiscard]] friend constexpr bool operator==(const basic_simple_stack_string_concat &lhs,
+    const std::basic_string_view<CharType> rhs) noexcept
+  {
+    if (lhs.size() != rhs.size()) { return false; }
+
+    bool equal = true;
+    size_type pos = 0;
+    lhs.for_each_piece([&](const value_type *str, const size_type count) {
+      equal = equal && std::char_traits<CharType>::compare(str, rhs.data() + pos, count) == 0;
+      pos += count;
+    });
+    return equal;
+  }
+
+  template<std::size_t OtherCapacity, typename OtherLHS, typename OtherRHS>
+  [[nodiscard]] friend constexpr bool operator==(const basic_simple_stack_string_concat &lhs,
+    const basic_simple_stack_string_concat<CharType, OtherCapacity, OtherLHS, OtherRHS> &rhs) noexcept
+  {
+    return lhs == std::basic_string_view<CharType>(rhs.str());
+  }
+
+  // spelled out, for C++17
+  [[nodiscard]] friend constexpr bool operator==(const std::basic_string_view<CharType> lhs,
+    const basic_simple_stack_string_concat &rhs) noexcept
+  {
+    return rhs == lhs;
+  }
+
+  [[nodiscard]] friend constexpr bool operator!=(const basic_simple_stack_string_concat &lhs,
+    const std::basic_string_view<CharType> rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+  [[nodiscard]] friend constexpr bool operator!=(const std::basic_string_view<CharType> lhs,
+    const basic_simple_stack_string_concat &rhs) noexcept
+  {
+    return !(rhs == lhs);
+  }
+
+  template<std::size_t OtherCapacity, typename OtherLHS, typename OtherRHS>
+  [[nodiscard]] friend constexpr bool operator!=(const basic_simple_stack_string_concat &lhs,
+    const basic_simple_stack_string_concat<CharType, OtherCapacity, OtherLHS, OtherRHS> &rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  template<typename Piece, typename Callable> static constexpr void visit_piece(const Piece &piece, Callable &callable)
+  {
+    if constexpr (is_basic_simple_stack_string_concat<Piece>::value) {
+      piece.for_each_piece(callable);
+    } else {
+      callable(piece.data(), piece.size());
+    }
+  }
+
+  LHS lhs_;
+  RHS rhs_;
+};
+
+template<typename CharType, std::size_t TotalCapacity, typename LHS, typename RHS>
+basic_simple_stack_string(basic_simple_stack_string_concat<CharType, TotalCapacity, LHS, RHS>)
+  -> basic_simple_stack_string<CharType, TotalCapacity>;
+
+// both sides must have the same character type
+template<typename LHS,
+  typename RHS,
+  typename LHSOperand = simple_stack_string_concat_operand_t<LHS>,
+  typename RHSOperand = simple_stack_string_concat_operand_t<RHS>,
+  typename = std::enable_if_t<LHSOperand::is_operand && RHSOperand::is_operand>,
+  typename = std::enable_if_t<std::is_same_v<typename LHSOperand::value_type, typename RHSOperand::value_type>>>
+[[nodiscard]] constexpr auto operator+(LHS &&lhs, RHS &&rhs)
 {
-  basic_simple_stack_string<CharType, LHSSize + RHSSize - 1> result{ lhs };
-  result += rhs;
-  return result;
+  return basic_simple_stack_string_concat<typename LHSOperand::value_type,
+    LHSOperand::total_capacity + RHSOperand::total_capacity - 1,
+    typename LHSOperand::storage_type,
+    typename RHSOperand::storage_type>{ std::forward<LHS>(lhs), std::forward<RHS>(rhs) };
 }
 
 template<std::size_t TotalCapacity> using simple_stack_string = basic_simple_stack_string<char, TotalCapacity>;
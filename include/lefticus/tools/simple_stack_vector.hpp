@@ -87,6 +87,9 @@ template<typename Contained, std::size_t Capacity> struct simple_stack_vector
     }
   }
 
+  [[nodiscard]] constexpr value_type *data() noexcept { return data_.data(); }
+  [[nodiscard]] constexpr const value_type *data() const noexcept { return data_.data(); }
+
   [[nodiscard]] constexpr iterator begin() noexcept { return data_.begin(); }
 
   [[nodiscard]] constexpr const_iterator begin() const noexcept { return data_.cbegin(); }
@@ -189,7 +192,7 @@ template<typename Contained, std::size_t Capacity> struct simple_stack_vector
         size_ = new_size;
         auto new_end = end();
         while (old_end != new_end) {
-          *old_end = data_type{};
+          *old_end = value_type{};
           ++old_end;
         }
       }
@@ -0,0 +1,263 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_SLOT_MAP_HPP
+#define LEFTICUS_TOOLS_SLOT_MAP_HPP
+
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simple_stack_vector.hpp"
+
+namespace lefticus::tools {
+
+// An index into a slot_map plus the generation of the slot at the time
+// the handle was created. Once the slot is erased the generation moves
+// on and the old handle no longer finds anything.
+//
+// A default constructed handle never refers to anything.
+template<typename Underlying, std::size_t IndexBits> struct slot_handle
+{
+  using value_type = Underlying;
+
+  static_assert(std::is_unsigned_v<Underlying>);
+  static_assert(IndexBits > 0 && IndexBits < sizeof(Underlying) * CHAR_BIT);
+
+  static constexpr std::size_t index_bits = IndexBits;
+  static constexpr auto index_mask = static_cast<Underlying>((Underlying{ 1 } << IndexBits) - 1);
+  // the largest index is reserved for "nothing"
+  static constexpr Underlying null_index = index_mask;
+
+  constexpr slot_handle() = default;
+  constexpr slot_handle(const Underlying index, const Underlying generation) noexcept
+    : value{ static_cast<Underlying>(static_cast<Underlying>(generation << IndexBits) | (index & index_mask)) }
+  {}
+
+  [[nodiscard]] constexpr Underlying index() const noexcept { return value & index_mask; }
+  [[nodiscard]] constexpr Underlying generation() const noexcept { return static_cast<Underlying>(value >> IndexBits); }
+  [[nodiscard]] constexpr Underlying get() const noexcept { return value; }
+
+  // generations wrap around, which is what limits how many times a slot
+  // can be reused before an old handle could be mistaken for a new one
+  [[nodiscard]] constexpr slot_handle next_generation() const noexcept
+  {
+    return slot_handle{ index(), static_cast<Underlying>(generation() + 1) };
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const slot_handle lhs, const slot_handle rhs) noexcept
+  {
+    return lhs.value == rhs.value;
+  }
+  [[nodiscard]] friend constexpr bool operator!=(const slot_handle lhs, const slot_handle rhs) noexcept
+  {
+    return lhs.value != rhs.value;
+  }
+
+private:
+  Underlying value{ null_index };
+};
+
+// ~1M live objects, 4096 generations per slot
+using slot_handle32 = slot_handle<std::uint32_t, 20>;
+// ~4G live objects, ~4G generations per slot
+using slot_handle64 = slot_handle<std::uint64_t, 32>;
+
+
+// Values are kept densely packed in ValueContainer, so iterating a
+// slot_map is iterating a contiguous container. Erasing moves the last
+// value into the hole, so iterators and references are invalidated by
+// erase, but handles are not.
+//
+// HandleContainer holds two tables:
+//  * slots: for a live slot the index is the position in the dense
+//    values, for a free slot it is the next free slot
+//  * handles: the handle of each dense value, used to fix up the slot
+//    of the value that gets moved on erase
+template<typename Value, typename Handle, typename ValueContainer, typename HandleContainer> struct slot_map_adapter
+{
+  using value_type = Value;
+  using handle_type = Handle;
+  using size_type = typename ValueContainer::size_type;
+  using difference_type = typename ValueContainer::difference_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  using iterator = typename ValueContainer::iterator;
+  using const_iterator = typename ValueContainer::const_iterator;
+
+  using index_type = typename Handle::value_type;
+
+  constexpr slot_map_adapter() = default;
+
+  template<typename... Param> constexpr handle_type emplace(Param &&...param)
+  {
+    const auto dense = static_cast<index_type>(values_.size());
+    const bool reuse_slot = free_head_ != Handle::null_index;
+    const auto slot = reuse_slot ? free_head_ : static_cast<index_type>(slots_.size());
+
+    if (!reuse_slot && slot == Handle::null_index) {
+      throw std::length_error("emplace would exceed the index range of slot_map handle");
+    }
+
+    values_.emplace_back(std::forward<Param>(param)...);
+
+    if (reuse_slot) {
+      free_head_ = slots_[slot].index();
+      slots_[slot] = handle_type{ dense, slots_[slot].generation() };
+    } else {
+      slots_.push_back(handle_type{ dense, 0 });
+    }
+
+    const handle_type result{ slot, slots_[slot].generation() };
+    handles_.push_back(result);
+    return result;
+  }
+
+  constexpr handle_type insert(const value_type &value) { return emplace(value); }
+  constexpr handle_type insert(value_type &&value) { return emplace(std::move(value)); }
+
+  // returns false if the handle was already stale
+  constexpr bool erase(const handle_type handle)
+  {
+    if (!contains(handle)) { return false; }
+
+    const auto slot = handle.index();
+    const auto dense = slots_[slot].index();
+    const auto last = static_cast<index_type>(values_.size() - 1);
+
+    if (dense != last) {
+      values_[dense] = std::move(values_[last]);
+      handles_[dense] = handles_[last];
+      const auto moved_slot = handles_[dense].index();
+      slots_[moved_slot] = handle_type{ dense, slots_[moved_slot].generation() };
+    }
+
+    values_.pop_back();
+    handles_.pop_back();
+
+    slots_[slot] = handle_type{ free_head_, slots_[slot].generation() }.next_generation();
+    free_head_ = slot;
+    return true;
+  }
+
+  [[nodiscard]] constexpr bool contains(const handle_type handle) const noexcept
+  {
+    const auto slot = handle.index();
+    if (slot >= slots_.size() || slots_[slot].generation() != handle.generation()) { return false; }
+    // free slots can share a generation with a forged or wrapped around handle
+    const auto dense = slots_[slot].index();
+    return dense < handles_.size() && handles_[dense] == handle;
+  }
+
+  [[nodiscard]] constexpr value_type *find(const handle_type handle) noexcept
+  {
+    return contains(handle) ? &values_[slots_[handle.index()].index()] : nullptr;
+  }
+
+  [[nodiscard]] constexpr const value_type *find(const handle_type handle) const noexcept
+  {
+    return contains(handle) ? &values_[slots_[handle.index()].index()] : nullptr;
+  }
+
+  [[nodiscard]] constexpr value_type &at(const handle_type handle)
+  {
+    if (!contains(handle)) { throw std::out_of_range("stale handle passed to slot_map"); }
+    return values_[slots_[handle.index()].index()];
+  }
+
+  [[nodiscard]] constexpr const value_type &at(const handle_type handle) const
+  {
+    if (!contains(handle)) { throw std::out_of_range("stale handle passed to slot_map"); }
+    return values_[slots_[handle.index()].index()];
+  }
+
+  // unchecked
+  [[nodiscard]] constexpr value_type &operator[](const handle_type handle) noexcept
+  {
+    return values_[slots_[handle.index()].index()];
+  }
+
+  [[nodiscard]] constexpr const value_type &operator[](const handle_type handle) const noexcept
+  {
+    return values_[slots_[handle.index()].index()];
+  }
+
+  // erases everything, all outstanding handles become stale
+  constexpr void clear()
+  {
+    for (const auto handle : handles_) {
+      const auto slot = handle.index();
+      slots_[slot] = handle_type{ free_head_, slots_[slot].generation() }.next_generation();
+      free_head_ = slot;
+    }
+
+    values_.clear();
+    handles_.clear();
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return values_.begin(); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return values_.begin(); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return values_.cbegin(); }
+
+  [[nodiscard]] constexpr iterator end() noexcept { return values_.end(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return values_.end(); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return values_.cend(); }
+
+  // the densely packed values, in iteration order
+  [[nodiscard]] constexpr const ValueContainer &values() const noexcept { return values_; }
+  // handles()[i] is the handle of values()[i]
+  [[nodiscard]] constexpr const HandleContainer &handles() const noexcept { return handles_; }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return values_.empty(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return values_.size(); }
+  [[nodiscard]] constexpr size_type max_size() const noexcept { return values_.max_size(); }
+
+private:
+  ValueContainer values_{};
+  HandleContainer handles_{};
+  HandleContainer slots_{};
+  index_type free_head_{ Handle::null_index };
+};
+
+template<typename Value, typename Handle = slot_handle32>
+using slot_map = slot_map_adapter<Value, Handle, std::vector<Value>, std::vector<Handle>>;
+
+// values must be default constructible, as with simple_stack_vector
+template<typename Value, std::size_t Capacity, typename Handle = slot_handle32>
+using simple_stack_slot_map =
+  slot_map_adapter<Value, Handle, simple_stack_vector<Value, Capacity>, simple_stack_vector<Handle, Capacity>>;
+
+
+}// namespace lefticus::tools
+
+
+#endif
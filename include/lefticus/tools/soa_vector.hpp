@@ -0,0 +1,334 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_SOA_VECTOR_HPP
+#define LEFTICUS_TOOLS_SOA_VECTOR_HPP
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "simple_stack_vector.hpp"
+#include "type_lists.hpp"
+
+namespace lefticus::tools {
+
+// Reference to one row of a soa_vector_adapter. Fields are reached with
+// get<Index>(), and structured bindings bind to references into the columns.
+template<typename Container> struct soa_row
+{
+  using container_type = Container;
+  using value_type = typename std::remove_const_t<Container>::value_type;
+  using size_type = typename std::remove_const_t<Container>::size_type;
+
+  constexpr soa_row(Container *container_, const size_type index_) noexcept
+    : container{ container_ }, index{ index_ }
+  {}
+  constexpr soa_row(const soa_row &) = default;
+
+  // assignment writes through to the row, it does not rebind the reference
+  constexpr const soa_row &operator=(const soa_row &other) const { return *this = static_cast<value_type>(other); }
+
+  Container *container;
+  size_type index;
+
+  template<std::size_t Index> [[nodiscard]] constexpr auto &get() const noexcept
+  {
+    return container->template column<Index>()[index];
+  }
+
+  // copies the row out
+  [[nodiscard]] constexpr operator value_type() const { return to_tuple(std::make_index_sequence<field_count>{}); }
+
+  constexpr const soa_row &operator=(const value_type &value) const
+  {
+    assign(value, std::make_index_sequence<field_count>{});
+    return *this;
+  }
+
+private:
+  static constexpr std::size_t field_count = std::tuple_size_v<value_type>;
+
+  template<std::size_t... Index> [[nodiscard]] constexpr value_type to_tuple(std::index_sequence<Index...>) const
+  {
+    return value_type{ get<Index>()... };
+  }
+
+  template<std::size_t... Index>
+  constexpr void assign(const value_type &value, std::index_sequence<Index...>) const
+  {
+    ((get<Index>() = std::get<Index>(value)), ...);
+  }
+};
+
+template<typename Container> struct soa_row_iterator
+{
+  using iterator_concept = std::random_access_iterator_tag;
+  // rows are proxies, so to legacy algorithms this is only an input iterator
+  using iterator_category = std::input_iterator_tag;
+  using value_type = typename std::remove_const_t<Container>::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = soa_row<Container>;
+
+  Container *container{};
+  std::size_t index{};
+
+  [[nodiscard]] constexpr reference operator*() const noexcept { return reference{ container, index }; }
+  [[nodiscard]] constexpr reference operator[](const difference_type offset) const noexcept
+  {
+    return *(*this + offset);
+  }
+
+  constexpr soa_row_iterator &operator++() noexcept
+  {
+    ++index;
+    return *this;
+  }
+  constexpr soa_row_iterator operator++(int) noexcept
+  {
+    auto result = *this;
+    ++index;
+    return result;
+  }
+  constexpr soa_row_iterator &operator--() noexcept
+  {
+    --index;
+    return *this;
+  }
+  constexpr soa_row_iterator operator--(int) noexcept
+  {
+    auto result = *this;
+    --index;
+    return result;
+  }
+
+  constexpr soa_row_iterator &operator+=(const difference_type offset) noexcept
+  {
+    index = static_cast<std::size_t>(static_cast<difference_type>(index) + offset);
+    return *this;
+  }
+  constexpr soa_row_iterator &operator-=(const difference_type offset) noexcept { return *this += -offset; }
+
+  [[nodiscard]] friend constexpr soa_row_iterator operator+(soa_row_iterator itr, const difference_type offset) noexcept
+  {
+    return itr += offset;
+  }
+  [[nodiscard]] friend constexpr soa_row_iterator operator+(const difference_type offset, soa_row_iterator itr) noexcept
+  {
+    return itr += offset;
+  }
+  [[nodiscard]] friend constexpr soa_row_iterator operator-(soa_row_iterator itr, const difference_type offset) noexcept
+  {
+    return itr -= offset;
+  }
+  [[nodiscard]] friend constexpr difference_type operator-(const soa_row_iterator &lhs,
+    const soa_row_iterator &rhs) noexcept
+  {
+    return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const soa_row_iterator &lhs, const soa_row_iterator &rhs) noexcept
+  {
+    return lhs.index == rhs.index;
+  }
+  [[nodiscard]] friend constexpr auto operator<=>(const soa_row_iterator &lhs, const soa_row_iterator &rhs) noexcept
+  {
+    return lhs.index <=> rhs.index;
+  }
+};
+
+template<typename Columns> struct soa_vector_adapter;
+
+// Struct of arrays, each field lives in its own contiguous Column container.
+//
+// Columns must provide data(), size(), push_back(), pop_back(), clear()
+// and resize(), and are always kept the same size.
+// (std::vector<bool> does not work as a column because it has no data())
+template<typename... Columns> struct soa_vector_adapter<type_list<Columns...>>
+{
+  static_assert(sizeof...(Columns) > 0);
+
+  using column_list = type_list<Columns...>;
+  using field_list = type_list<typename Columns::value_type...>;
+
+  template<std::size_t Index> using column_type = nth_t<Index, column_list>;
+  template<std::size_t Index> using field_type = nth_t<Index, field_list>;
+
+  using value_type = std::tuple<typename Columns::value_type...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = soa_row<soa_vector_adapter>;
+  using const_reference = soa_row<const soa_vector_adapter>;
+  using iterator = soa_row_iterator<soa_vector_adapter>;
+  using const_iterator = soa_row_iterator<const soa_vector_adapter>;
+
+  static constexpr std::size_t field_count = sizeof...(Columns);
+
+  constexpr soa_vector_adapter() = default;
+
+  constexpr explicit soa_vector_adapter(std::initializer_list<value_type> values)
+  {
+    for (const auto &value : values) { push_back(value); }
+  }
+
+  // contiguous view of one field of every row
+  template<std::size_t Index> [[nodiscard]] constexpr std::span<field_type<Index>> column() noexcept
+  {
+    auto &column = std::get<Index>(columns_);
+    return { column.data(), column.size() };
+  }
+
+  template<std::size_t Index> [[nodiscard]] constexpr std::span<const field_type<Index>> column() const noexcept
+  {
+    const auto &column = std::get<Index>(columns_);
+    return { column.data(), column.size() };
+  }
+
+  template<std::size_t Index> [[nodiscard]] constexpr auto get() noexcept { return column<Index>(); }
+  template<std::size_t Index> [[nodiscard]] constexpr auto get() const noexcept { return column<Index>(); }
+
+  constexpr void push_back(const value_type &value) { push_back(value, std::index_sequence_for<Columns...>{}); }
+
+  template<typename... Param> constexpr reference emplace_back(Param &&...param)
+  {
+    static_assert(sizeof...(Param) == field_count, "one value is required for every field");
+    std::apply([&](auto &...column) { (column.push_back(std::forward<Param>(param)), ...); }, columns_);
+    return back();
+  }
+
+  constexpr void pop_back()
+  {
+    std::apply([](auto &...column) { (column.pop_back(), ...); }, columns_);
+  }
+
+  constexpr void resize(const size_type new_size)
+  {
+    std::apply([new_size](auto &...column) { (column.resize(new_size), ...); }, columns_);
+  }
+
+  constexpr void clear()
+  {
+    std::apply([](auto &...column) { (column.clear(), ...); }, columns_);
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+  [[nodiscard]] constexpr size_type capacity() const noexcept { return std::get<0>(columns_).capacity(); }
+
+  [[nodiscard]] constexpr reference operator[](const size_type index) noexcept { return reference{ this, index }; }
+  [[nodiscard]] constexpr const_reference operator[](const size_type index) const noexcept
+  {
+    return const_reference{ this, index };
+  }
+
+  [[nodiscard]] constexpr reference at(const size_type index)
+  {
+    if (index >= size()) { throw std::out_of_range("index past end of soa_vector"); }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] constexpr const_reference at(const size_type index) const
+  {
+    if (index >= size()) { throw std::out_of_range("index past end of soa_vector"); }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] constexpr reference front() noexcept { return (*this)[0]; }
+  [[nodiscard]] constexpr const_reference front() const noexcept { return (*this)[0]; }
+  [[nodiscard]] constexpr reference back() noexcept { return (*this)[size() - 1]; }
+  [[nodiscard]] constexpr const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return iterator{ this, 0 }; }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator{ this, 0 }; }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] constexpr iterator end() noexcept { return iterator{ this, size() }; }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator{ this, size() }; }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+  // Calls callable with the selected fields of each row, in row order.
+  // The loop only touches the selected columns, through plain pointers,
+  // which is the shape compilers know how to vectorize.
+  //
+  // soa.for_each<0, 1>([](float &position, const float velocity) { position += velocity; });
+  template<std::size_t... Index, typename Callable> constexpr void for_each(Callable callable)
+  {
+    for_each_impl(callable, column<Index>().data()...);
+  }
+
+  template<std::size_t... Index, typename Callable> constexpr void for_each(Callable callable) const
+  {
+    for_each_impl(callable, column<Index>().data()...);
+  }
+
+private:
+  template<std::size_t... Index> constexpr void push_back(const value_type &value, std::index_sequence<Index...>)
+  {
+    (std::get<Index>(columns_).push_back(std::get<Index>(value)), ...);
+  }
+
+  template<typename Callable, typename... Pointer>
+  constexpr void for_each_impl(Callable &callable, Pointer... pointers) const
+  {
+    const auto count = size();
+    for (size_type index = 0; index < count; ++index) { callable(pointers[index]...); }
+  }
+
+  std::tuple<Columns...> columns_{};
+};
+
+// fixed capacity, each column is a simple_stack_vector
+template<std::size_t Capacity, typename... Fields>
+using stack_soa_vector = soa_vector_adapter<type_list<simple_stack_vector<Fields, Capacity>...>>;
+
+// growable, each column is a std::vector
+template<typename... Fields> using soa_vector = soa_vector_adapter<type_list<std::vector<Fields>...>>;
+
+
+}// namespace lefticus::tools
+
+// so structured bindings work on rows
+namespace std {
+template<typename Container>
+struct tuple_size<lefticus::tools::soa_row<Container>>
+  : tuple_size<typename lefticus::tools::soa_row<Container>::value_type>
+{
+};
+
+template<std::size_t Index, typename Container> struct tuple_element<Index, lefticus::tools::soa_row<Container>>
+{
+  using type = decltype(std::declval<lefticus::tools::soa_row<Container>>().template get<Index>());
+};
+}// namespace std
+
+#endif
@@ -0,0 +1,278 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_SPLIT_HPP
+#define LEFTICUS_TOOLS_SPLIT_HPP
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+#include "simple_stack_string.hpp"
+#include "simple_stack_vector.hpp"
+
+namespace lefticus::tools {
+
+struct split_options
+{
+  // once this many pieces have been split off, the rest of the text is
+  // returned as the last piece, like Python's str.split(sep, maxsplit)
+  std::size_t max_splits = std::numeric_limits<std::size_t>::max();
+  // drop empty pieces, so runs of delimiters act like one delimiter
+  bool skip_empty = false;
+};
+
+// A single delimiter character, found with traits_type::find (memchr for char)
+template<typename CharType> struct char_delimiter
+{
+  CharType delimiter{};
+
+  [[nodiscard]] constexpr std::size_t find_in(const std::basic_string_view<CharType> text) const noexcept
+  {
+    return text.find(delimiter);
+  }
+
+  [[nodiscard]] constexpr bool matches(const CharType c) const noexcept { return c == delimiter; }
+};
+
+// Any one of a set of delimiter characters, checked with a bitmap for
+// single byte character types. Two or three delimiters, as in CSV rows or
+// request lines, are checked 8 characters at a time at runtime instead.
+template<typename CharType> struct any_of_delimiter
+{
+  constexpr any_of_delimiter() = default;
+  constexpr explicit any_of_delimiter(const std::basic_string_view<CharType> delimiters) noexcept
+    : delimiters_{ delimiters }
+  {
+    if constexpr (sizeof(CharType) == 1) { bitmap_ = basic_char_bitmap<CharType>{ delimiters }; }
+  }
+
+  [[nodiscard]] constexpr std::size_t find_in(const std::basic_string_view<CharType> text) const noexcept
+  {
+    if constexpr (sizeof(CharType) == 1) {
+#ifdef LEFTICUS_TOOLS_HAS_WORD_SEARCH
+      if constexpr (word_search::enabled) {
+        if (!std::is_constant_evaluated() && delimiters_.size() >= 2 && delimiters_.size() <= 3) {
+          const auto found =
+            delimiters_.size() == 2
+              ? word_search::find_any(text.data(), text.size(), std::array{ delimiters_[0], delimiters_[1] })
+              : word_search::find_any(
+                text.data(), text.size(), std::array{ delimiters_[0], delimiters_[1], delimiters_[2] });
+          return found == text.size() ? std::basic_string_view<CharType>::npos : found;
+        }
+      }
+#endif
+      for (std::size_t idx = 0; idx < text.size(); ++idx) {
+        if (bitmap_.contains(text[idx])) { return idx; }
+      }
+      return std::basic_string_view<CharType>::npos;
+    } else {
+      return text.find_first_of(delimiters_);
+    }
+  }
+
+  [[nodiscard]] constexpr bool matches(const CharType c) const noexcept
+  {
+    if constexpr (sizeof(CharType) == 1) {
+      return bitmap_.contains(c);
+    } else {
+      return delimiters_.find(c) != std::basic_string_view<CharType>::npos;
+    }
+  }
+
+private:
+  std::basic_string_view<CharType> delimiters_{};
+  struct empty_bitmap
+  {
+  };
+  [[no_unique_address]] std::conditional_t<sizeof(CharType) == 1, basic_char_bitmap<CharType>, empty_bitmap> bitmap_{};
+};
+
+
+// Walks the pieces of a string one at a time, never allocates or copies,
+// every piece is a view into the original text
+template<typename CharType, typename Delimiter> struct basic_splitter
+{
+  using string_view_type = std::basic_string_view<CharType>;
+
+  constexpr basic_splitter() = default;
+  constexpr basic_splitter(const string_view_type text, const Delimiter delimiter, const split_options options) noexcept
+    : text_{ text }, delimiter_{ delimiter }, options_{ options }
+  {}
+
+  // std::nullopt once every piece has been returned
+  [[nodiscard]] constexpr std::optional<string_view_type> next() noexcept
+  {
+    while (!done_) {
+      string_view_type piece;
+
+      if (splits_ == options_.max_splits) {
+        if (options_.skip_empty) { skip_leading_delimiters(); }
+        piece = text_;
+        done_ = true;
+      } else {
+        const auto pos = delimiter_.find_in(text_);
+        if (pos == string_view_type::npos) {
+          piece = text_;
+          done_ = true;
+        } else {
+          piece = text_.substr(0, pos);
+          text_.remove_prefix(pos + 1);
+        }
+      }
+
+      if (options_.skip_empty && piece.empty()) { continue; }
+      if (!done_) { ++splits_; }
+      return piece;
+    }
+
+    return std::nullopt;
+  }
+
+  [[nodiscard]] constexpr bool done() const noexcept { return done_; }
+
+private:
+  constexpr void skip_leading_delimiters() noexcept
+  {
+    while (!text_.empty() && delimiter_.matches(text_.front())) { text_.remove_prefix(1); }
+  }
+
+  string_view_type text_{};
+  Delimiter delimiter_{};
+  split_options options_{};
+  std::size_t splits_ = 0;
+  bool done_ = false;
+};
+
+
+// Lazy forward range over the pieces of a string
+template<typename CharType, typename Delimiter>
+struct basic_split_view : std::ranges::view_interface<basic_split_view<CharType, Delimiter>>
+{
+  using splitter_type = basic_splitter<CharType, Delimiter>;
+  using string_view_type = std::basic_string_view<CharType>;
+
+  struct iterator
+  {
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = string_view_type;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr explicit iterator(const splitter_type &splitter) : splitter_{ splitter }, current_{ splitter_.next() } {}
+
+    [[nodiscard]] constexpr value_type operator*() const noexcept { return *current_; }// NOLINT (unchecked access)
+
+    constexpr iterator &operator++() noexcept
+    {
+      current_ = splitter_.next();
+      return *this;
+    }
+
+    constexpr iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++(*this);
+      return result;
+    }
+
+    // pieces are views into the same text, so the position of the piece identifies it
+    [[nodiscard]] constexpr bool operator==(const iterator &rhs) const noexcept
+    {
+      if (!current_ || !rhs.current_) { return !current_ && !rhs.current_; }
+      return current_->data() == rhs.current_->data() && current_->size() == rhs.current_->size();
+    }
+
+    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept { return !current_; }
+
+  private:
+    splitter_type splitter_{};
+    std::optional<string_view_type> current_{};
+  };
+
+  constexpr basic_split_view() = default;
+  constexpr explicit basic_split_view(const splitter_type splitter) noexcept : splitter_{ splitter } {}
+
+  [[nodiscard]] constexpr iterator begin() const { return iterator{ splitter_ }; }
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+  splitter_type splitter_{};
+};
+
+
+[[nodiscard]] constexpr auto split(const std::string_view text, const char delimiter, const split_options options = {})
+{
+  return basic_split_view{ basic_splitter{ text, char_delimiter<char>{ delimiter }, options } };
+}
+
+// splits on any one of the characters in delimiters
+[[nodiscard]] constexpr auto
+  split(const std::string_view text, const std::string_view delimiters, const split_options options = {})
+{
+  return basic_split_view{ basic_splitter{ text, any_of_delimiter<char>{ delimiters }, options } };
+}
+
+// A generator in the style of lambda_coroutines, each call returns the
+// next piece or std::nullopt, use with lambda_coroutines::while_has_value
+[[nodiscard]] constexpr auto
+  split_generator(const std::string_view text, const char delimiter, const split_options options = {})
+{
+  return [splitter = basic_splitter{ text, char_delimiter<char>{ delimiter }, options }]() mutable {
+    return splitter.next();
+  };
+}
+
+[[nodiscard]] constexpr auto
+  split_generator(const std::string_view text, const std::string_view delimiters, const split_options options = {})
+{
+  return [splitter = basic_splitter{ text, any_of_delimiter<char>{ delimiters }, options }]() mutable {
+    return splitter.next();
+  };
+}
+
+// throws std::length_error if there are more than Capacity pieces
+template<std::size_t Capacity, typename Delimiter>
+[[nodiscard]] constexpr simple_stack_vector<std::string_view, Capacity>
+  split_to(const std::string_view text, const Delimiter &delimiters, const split_options options = {})
+{
+  simple_stack_vector<std::string_view, Capacity> result;
+  for (const auto piece : split(text, delimiters, options)) { result.push_back(piece); }
+  return result;
+}
+
+}// namespace lefticus::tools
+
+#endif
@@ -0,0 +1,230 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_STACK_ARENA_HPP
+#define LEFTICUS_TOOLS_STACK_ARENA_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace lefticus::tools {
+
+enum struct arena_mode {
+  // deallocation only reclaims memory if it was the most recent allocation
+  monotonic,
+  // deallocated blocks are kept on a free list and reused by later allocations
+  free_list
+};
+
+// A fixed size buffer exposed as a std::pmr::memory_resource
+//  * it never allocates from anywhere else, std::bad_alloc is thrown when full
+//  * release() gives back everything at once in O(1)
+//  * nothing is ever destroyed by the arena itself, that is the job of the
+//    containers using it
+//  * the arena must outlive everything allocated from it
+template<std::size_t Bytes, arena_mode Mode = arena_mode::monotonic>
+struct stack_arena final : std::pmr::memory_resource
+{
+  stack_arena() = default;
+  stack_arena(const stack_arena &) = delete;
+  stack_arena(stack_arena &&) = delete;
+  stack_arena &operator=(const stack_arena &) = delete;
+  stack_arena &operator=(stack_arena &&) = delete;
+  ~stack_arena() override = default;
+
+  // forget about every allocation, does not call any destructors
+  void release() noexcept
+  {
+    offset_ = 0;
+    bytes_in_use_ = 0;
+    free_list_ = nullptr;
+  }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static std::size_t capacity() noexcept { return Bytes; }
+
+  // number of bytes requested by live allocations
+  [[nodiscard]] std::size_t bytes_in_use() const noexcept { return bytes_in_use_; }
+
+  // number of bytes of the buffer currently handed out, including padding and freed blocks
+  [[nodiscard]] std::size_t bytes_reserved() const noexcept { return offset_; }
+
+  // the most of the buffer that has ever been handed out, use this for sizing arenas
+  [[nodiscard]] std::size_t high_water_mark() const noexcept { return high_water_mark_; }
+
+  [[nodiscard]] std::size_t allocation_count() const noexcept { return allocation_count_; }
+
+private:
+  struct free_block
+  {
+    free_block *next;
+    std::size_t size;
+  };
+
+  [[nodiscard]] static constexpr std::size_t round_up(const std::size_t value, const std::size_t alignment) noexcept
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  [[nodiscard]] static std::size_t block_size(std::size_t bytes) noexcept
+  {
+    if constexpr (Mode == arena_mode::free_list) {
+      // Every block must be able to hold a free_block when it is given back.
+      // Rounding to a whole number of free_blocks also means that splitting
+      // a block never leaves a tail too small to go back on the free list.
+      return round_up(std::max(bytes, sizeof(free_block)), sizeof(free_block));
+    } else {
+      return bytes;
+    }
+  }
+
+  [[nodiscard]] static bool is_aligned(const void *ptr, const std::size_t alignment) noexcept
+  {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;// NOLINT (pointer to integer)
+  }
+
+  [[nodiscard]] void *take_from_free_list(const std::size_t bytes, const std::size_t alignment) noexcept
+  {
+    for (free_block **link = &free_list_; *link != nullptr; link = &(*link)->next) {
+      free_block *block = *link;
+      if (block->size < bytes || !is_aligned(block, alignment)) { continue; }
+
+      const auto remaining = block->size - bytes;
+      if (remaining >= sizeof(free_block)) {
+        // split the block and leave the tail on the free list
+        auto *tail = new (reinterpret_cast<std::byte *>(block) + bytes) free_block{ block->next, remaining };// NOLINT
+        *link = tail;
+      } else {
+        *link = block->next;
+      }
+      return block;
+    }
+
+    return nullptr;
+  }
+
+  void *do_allocate(const std::size_t requested, const std::size_t alignment) override
+  {
+    const auto bytes = block_size(requested);
+
+    void *result = nullptr;
+    if constexpr (Mode == arena_mode::free_list) { result = take_from_free_list(bytes, alignment); }
+
+    if (result == nullptr) {
+      std::byte *const current = buffer_.data() + offset_;
+      const auto address = reinterpret_cast<std::uintptr_t>(current);// NOLINT (pointer to integer)
+      const std::size_t padding = round_up(address, alignment) - address;
+
+      if (padding > Bytes - offset_ || bytes > Bytes - offset_ - padding) { throw std::bad_alloc(); }
+
+      result = current + padding;
+      offset_ += padding + bytes;
+      high_water_mark_ = std::max(high_water_mark_, offset_);
+    }
+
+    bytes_in_use_ += requested;
+    ++allocation_count_;
+    return result;
+  }
+
+  void do_deallocate(void *ptr, const std::size_t requested, [[maybe_unused]] const std::size_t alignment) override
+  {
+    const auto bytes = block_size(requested);
+    bytes_in_use_ -= requested;
+
+    auto *const block = static_cast<std::byte *>(ptr);
+    if (block + bytes == buffer_.data() + offset_) {
+      // most recent allocation, just move the top back down
+      offset_ = static_cast<std::size_t>(block - buffer_.data());
+    } else if constexpr (Mode == arena_mode::free_list) {
+      free_list_ = new (ptr) free_block{ free_list_, bytes };
+    }
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  alignas(std::max_align_t) std::array<std::byte, Bytes> buffer_;
+  std::size_t offset_{};
+  std::size_t bytes_in_use_{};
+  std::size_t high_water_mark_{};
+  std::size_t allocation_count_{};
+  free_block *free_list_{};
+};
+
+
+// Stateless allocator for an arena with static storage duration, so
+// standard containers can use an arena without paying for a pointer
+// in every container object or going through std::pmr's virtual calls
+//
+// static stack_arena<1024> arena;
+// std::vector<int, arena_allocator<int, arena>> vec;
+template<typename Value, auto &Arena> struct arena_allocator
+{
+  using value_type = Value;
+  using is_always_equal = std::true_type;
+
+  template<typename Other> struct rebind
+  {
+    using other = arena_allocator<Other, Arena>;
+  };
+
+  constexpr arena_allocator() noexcept = default;
+
+  // cppcheck-suppress noExplicitConstructor
+  template<typename Other> constexpr arena_allocator(const arena_allocator<Other, Arena> &) noexcept {}// NOLINT
+
+  [[nodiscard]] Value *allocate(const std::size_t count)
+  {
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(Value)) { throw std::bad_array_new_length(); }
+    return static_cast<Value *>(Arena.allocate(count * sizeof(Value), alignof(Value)));
+  }
+
+  void deallocate(Value *ptr, const std::size_t count) noexcept
+  {
+    Arena.deallocate(ptr, count * sizeof(Value), alignof(Value));
+  }
+
+  template<typename Other>
+  [[nodiscard]] friend constexpr bool operator==(const arena_allocator &, const arena_allocator<Other, Arena> &) noexcept
+  {
+    return true;
+  }
+};
+
+}// namespace lefticus::tools
+
+#endif
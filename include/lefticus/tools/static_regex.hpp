@@ -0,0 +1,626 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_STATIC_REGEX_HPP
+#define LEFTICUS_TOOLS_STATIC_REGEX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simple_stack_string.hpp"
+#include "static_views.hpp"
+
+namespace lefticus::tools {
+
+// A string literal usable as a template parameter, static_regex<"[a-z]+">
+template<std::size_t Size> struct regex_pattern
+{
+  std::array<char, Size> data{};
+
+  consteval regex_pattern(const char (&str)[Size])// NOLINT (implicit)
+  {
+    for (std::size_t index = 0; index < Size; ++index) { data[index] = str[index]; }
+  }
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept { return std::string_view(data.data(), Size - 1); }
+};
+
+struct regex_nfa_state
+{
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  // a byte state moves to out on any byte in bytes, anything else is an
+  // epsilon state, which moves to out and out2 without consuming input
+  basic_char_bitmap<char> bytes{};
+  bool is_byte = false;
+  std::size_t out = npos;
+  std::size_t out2 = npos;
+};
+
+// Thompson construction, straight from the pattern into NFA states.
+//
+// Supported: literals, '.', [classes] with ranges and [^negation],
+// \d \w \s \D \W \S, \t \n \r and escaped punctuation, * + ?, |,
+// (groups) and (?:groups), ^ at the start and $ at the end of the pattern.
+struct regex_parser
+{
+  struct fragment
+  {
+    std::size_t start;
+    // an epsilon state with nothing attached yet
+    std::size_t end;
+  };
+
+  std::string_view pattern;
+  std::vector<regex_nfa_state> states{};
+  std::size_t pos = 0;
+
+  constexpr fragment parse_alternation()
+  {
+    auto result = parse_concatenation();
+    while (pos < pattern.size() && pattern[pos] == '|') {
+      ++pos;
+      const auto rhs = parse_concatenation();
+      const auto start = add_epsilon(result.start, rhs.start);
+      const auto end = add_epsilon();
+      states[result.end].out = end;
+      states[rhs.end].out = end;
+      result = fragment{ start, end };
+    }
+    return result;
+  }
+
+private:
+  constexpr std::size_t add_epsilon(const std::size_t out = regex_nfa_state::npos,
+    const std::size_t out2 = regex_nfa_state::npos)
+  {
+    states.push_back(regex_nfa_state{ {}, false, out, out2 });
+    return states.size() - 1;
+  }
+
+  constexpr fragment add_bytes(const basic_char_bitmap<char> &bytes)
+  {
+    const auto end = add_epsilon();
+    states.push_back(regex_nfa_state{ bytes, true, end, regex_nfa_state::npos });
+    return fragment{ states.size() - 1, end };
+  }
+
+  constexpr fragment parse_concatenation()
+  {
+    const auto empty = add_epsilon();
+    fragment result{ empty, empty };
+    while (pos < pattern.size() && pattern[pos] != '|' && pattern[pos] != ')') {
+      const auto next = parse_repetition();
+      states[result.end].out = next.start;
+      result.end = next.end;
+    }
+    return result;
+  }
+
+  constexpr fragment parse_repetition()
+  {
+    auto result = parse_atom();
+    while (pos < pattern.size() && (pattern[pos] == '*' || pattern[pos] == '+' || pattern[pos] == '?')) {
+      const auto op = pattern[pos++];
+      const auto end = add_epsilon();
+      if (op == '*') {
+        states[result.end].out = result.start;
+        states[result.end].out2 = end;
+        result = fragment{ add_epsilon(result.start, end), end };
+      } else if (op == '+') {
+        states[result.end].out = result.start;
+        states[result.end].out2 = end;
+        result.end = end;
+      } else {
+        states[result.end].out = end;
+        result = fragment{ add_epsilon(result.start, end), end };
+      }
+    }
+    return result;
+  }
+
+  constexpr fragment parse_atom()
+  {
+    const auto c = pattern[pos++];
+    switch (c) {
+    case '(': {
+      if (pattern.substr(pos).starts_with("?:")) { pos += 2; }
+      const auto result = parse_alternation();
+      if (pos == pattern.size() || pattern[pos] != ')') { throw std::logic_error("unbalanced ( in regex"); }
+      ++pos;
+      return result;
+    }
+    case '[':
+      return add_bytes(parse_class());
+    case '.': {
+      basic_char_bitmap<char> bytes;
+      for (int byte = 0; byte < 256; ++byte) {// NOLINT Magic Number
+        if (byte != '\n') { bytes.insert(static_cast<char>(byte)); }
+      }
+      return add_bytes(bytes);
+    }
+    case '\\':
+      return add_bytes(parse_escape());
+    case '*':
+    case '+':
+    case '?':
+      throw std::logic_error("quantifier without anything to repeat in regex");
+    case '^':
+    case '$':
+      throw std::logic_error("^ and $ are only supported at the start and end of a regex");
+    default: {
+      basic_char_bitmap<char> bytes;
+      bytes.insert(c);
+      return add_bytes(bytes);
+    }
+    }
+  }
+
+  static constexpr basic_char_bitmap<char> complement(const basic_char_bitmap<char> &bytes)
+  {
+    basic_char_bitmap<char> result;
+    for (int byte = 0; byte < 256; ++byte) {// NOLINT Magic Number
+      if (!bytes.contains(static_cast<char>(byte))) { result.insert(static_cast<char>(byte)); }
+    }
+    return result;
+  }
+
+  static constexpr void insert_range(basic_char_bitmap<char> &bytes, const char first, const char last)
+  {
+    for (auto byte = static_cast<unsigned char>(first); byte <= static_cast<unsigned char>(last); ++byte) {
+      bytes.insert(static_cast<char>(byte));
+      if (byte == 255) { break; }// NOLINT Magic Number
+    }
+  }
+
+  constexpr basic_char_bitmap<char> parse_escape()
+  {
+    if (pos == pattern.size()) { throw std::logic_error("regex ends with \\"); }
+    const auto c = pattern[pos++];
+    basic_char_bitmap<char> bytes;
+    switch (c) {
+    case 'd':
+    case 'D':
+      insert_range(bytes, '0', '9');
+      break;
+    case 'w':
+    case 'W':
+      insert_range(bytes, 'a', 'z');
+      insert_range(bytes, 'A', 'Z');
+      insert_range(bytes, '0', '9');
+      bytes.insert('_');
+      break;
+    case 's':
+    case 'S':
+      for (const auto space : std::string_view{ " \t\n\r\f\v" }) { bytes.insert(space); }
+      break;
+    case 't':
+      bytes.insert('\t');
+      break;
+    case 'n':
+      bytes.insert('\n');
+      break;
+    case 'r':
+      bytes.insert('\r');
+      break;
+    default:
+      if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+        throw std::logic_error("unsupported escape in regex");
+      }
+      bytes.insert(c);
+    }
+    return c == 'D' || c == 'W' || c == 'S' ? complement(bytes) : bytes;
+  }
+
+  constexpr basic_char_bitmap<char> parse_class()
+  {
+    const bool negated = pos < pattern.size() && pattern[pos] == '^';
+    if (negated) { ++pos; }
+
+    basic_char_bitmap<char> bytes;
+    bool first = true;
+    while (pos < pattern.size() && (pattern[pos] != ']' || first)) {
+      first = false;
+      if (pattern[pos] == '\\') {
+        ++pos;
+        const auto escaped = parse_escape();
+        for (int byte = 0; byte < 256; ++byte) {// NOLINT Magic Number
+          if (escaped.contains(static_cast<char>(byte))) { bytes.insert(static_cast<char>(byte)); }
+        }
+        continue;
+      }
+
+      const auto low = pattern[pos++];
+      if (pos + 1 < pattern.size() && pattern[pos] == '-' && pattern[pos + 1] != ']') {
+        const auto high = pattern[pos + 1];
+        if (static_cast<unsigned char>(high) < static_cast<unsigned char>(low)) {
+          throw std::logic_error("reversed range in regex class");
+        }
+        insert_range(bytes, low, high);
+        pos += 2;
+      } else {
+        bytes.insert(low);
+      }
+    }
+
+    if (pos == pattern.size()) { throw std::logic_error("unbalanced [ in regex"); }
+    ++pos;
+    return negated ? complement(bytes) : bytes;
+  }
+};
+
+struct regex_dfa_layout
+{
+  std::vector<std::uint8_t> byte_classes;
+  std::size_t class_count{};
+  // state 0 is the dead state, state 1 is the start
+  std::vector<std::size_t> transitions;
+  std::vector<std::uint8_t> accepts;
+  bool anchored_start = false;
+  bool anchored_end = false;
+};
+
+// the search DFA is only a shortcut, patterns whose search DFA would be
+// larger than this go without it rather than failing to compile
+inline constexpr std::size_t max_regex_search_states = 64;
+
+// subset construction over byte classes: bytes that every NFA byte state
+// treats the same way share a column of the transition table
+//
+// With search set, a new match may begin at every byte, as if the pattern
+// started with .*, so the DFA accepts wherever any match ends. If that
+// needs more than max_regex_search_states states, the layout has no
+// transitions and no accepts.
+constexpr regex_dfa_layout make_regex_dfa_layout(std::string_view pattern, const bool search = false)
+{
+  regex_dfa_layout layout;
+
+  if (pattern.starts_with('^')) {
+    layout.anchored_start = true;
+    pattern.remove_prefix(1);
+  }
+  if (pattern.ends_with('$')) {
+    std::size_t backslashes = 0;
+    while (backslashes + 1 < pattern.size() && pattern[pattern.size() - 2 - backslashes] == '\\') { ++backslashes; }
+    if (backslashes % 2 == 0) {
+      layout.anchored_end = true;
+      pattern.remove_suffix(1);
+    }
+  }
+
+  regex_parser parser{ pattern };
+  const auto nfa = parser.parse_alternation();
+  if (parser.pos != pattern.size()) { throw std::logic_error("unbalanced ) in regex"); }
+  const auto &states = parser.states;
+  const auto accept = nfa.end;
+
+  std::vector<std::size_t> representatives;
+  layout.byte_classes.resize(256);// NOLINT Magic Number
+  for (std::size_t byte = 0; byte < 256; ++byte) {// NOLINT Magic Number
+    const auto same_class = [&](const std::size_t other) {
+      for (const auto &state : states) {
+        if (state.is_byte
+            && state.bytes.contains(static_cast<char>(byte)) != state.bytes.contains(static_cast<char>(other))) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    std::size_t byte_class = 0;
+    while (byte_class < representatives.size() && !same_class(representatives[byte_class])) { ++byte_class; }
+    if (byte_class == representatives.size()) { representatives.push_back(byte); }
+    layout.byte_classes[byte] = static_cast<std::uint8_t>(byte_class);
+  }
+  layout.class_count = representatives.size();
+
+  using state_set = std::vector<bool>;
+  const auto closure = [&](state_set set) {
+    std::vector<std::size_t> pending;
+    for (std::size_t index = 0; index < set.size(); ++index) {
+      if (set[index]) { pending.push_back(index); }
+    }
+    while (!pending.empty()) {
+      const auto &state = states[pending.back()];
+      pending.pop_back();
+      if (state.is_byte) { continue; }
+      for (const auto out : { state.out, state.out2 }) {
+        if (out != regex_nfa_state::npos && !set[out]) {
+          set[out] = true;
+          pending.push_back(out);
+        }
+      }
+    }
+    return set;
+  };
+
+  std::vector<state_set> sets;
+  sets.emplace_back(states.size(), false);
+  state_set start(states.size(), false);
+  start[nfa.start] = true;
+  sets.push_back(closure(start));
+
+  layout.transitions.resize(layout.class_count, 0);
+  for (std::size_t current = 1; current < sets.size(); ++current) {
+    for (std::size_t byte_class = 0; byte_class < layout.class_count; ++byte_class) {
+      const auto byte = static_cast<char>(representatives[byte_class]);
+      state_set next(states.size(), false);
+      for (std::size_t index = 0; index < states.size(); ++index) {
+        if (sets[current][index] && states[index].is_byte && states[index].bytes.contains(byte)) {
+          next[states[index].out] = true;
+        }
+      }
+      if (search) { next[nfa.start] = true; }
+      next = closure(std::move(next));
+
+      std::size_t target = 0;
+      while (target < sets.size() && sets[target] != next) { ++target; }
+      if (target == sets.size()) {
+        if (search && sets.size() == max_regex_search_states) {
+          layout.transitions.clear();
+          return layout;
+        }
+        if (sets.size() == 65536) { throw std::logic_error("regex needs too many DFA states"); }// NOLINT
+        sets.push_back(std::move(next));
+      }
+      layout.transitions.push_back(target);
+    }
+  }
+
+  for (const auto &set : sets) { layout.accepts.push_back(set[accept] ? 1 : 0); }
+  return layout;
+}
+
+template<typename Value, std::size_t Size, std::size_t Member>
+constexpr auto to_regex_dfa_array(const std::string_view pattern, const bool search = false)
+{
+  const auto layout = make_regex_dfa_layout(pattern, search);
+  const auto &source = [&]() -> const auto & {
+    if constexpr (Member == 0) {
+      return layout.byte_classes;
+    } else if constexpr (Member == 1) {
+      return layout.transitions;
+    } else {
+      return layout.accepts;
+    }
+  }();
+
+  std::array<Value, Size> result{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    if constexpr (std::is_same_v<Value, typename std::decay_t<decltype(source)>::value_type>) {
+      result[index] = source[index];
+    } else {
+      result[index] = static_cast<Value>(source[index]);
+    }
+  }
+  return result;
+}
+
+
+// The views returned by find_all, each match is searched for as the
+// iterator advances
+template<typename Regex> struct regex_match_view : std::ranges::view_interface<regex_match_view<Regex>>
+{
+  struct iterator
+  {
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr explicit iterator(const std::string_view text) : text_{ text }, current_{ Regex::search(text, 0) } {}
+
+    [[nodiscard]] constexpr value_type operator*() const noexcept { return *current_; }// NOLINT (unchecked access)
+
+    constexpr iterator &operator++() noexcept
+    {
+      const auto end = static_cast<std::size_t>(current_->data() - text_.data()) + current_->size();
+      // an empty match would be found again at the same place
+      const auto next = current_->empty() ? end + 1 : end;
+      current_ = next > text_.size() ? std::nullopt : Regex::search(text_, next);
+      return *this;
+    }
+
+    constexpr iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++(*this);
+      return result;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const iterator &rhs) const noexcept
+    {
+      if (!current_ || !rhs.current_) { return !current_ && !rhs.current_; }
+      return current_->data() == rhs.current_->data() && current_->size() == rhs.current_->size();
+    }
+
+    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept { return !current_; }
+
+  private:
+    std::string_view text_{};
+    std::optional<std::string_view> current_{};
+  };
+
+  constexpr regex_match_view() = default;
+  constexpr explicit regex_match_view(const std::string_view text) noexcept : text_{ text } {}
+
+  [[nodiscard]] constexpr iterator begin() const { return iterator{ text_ }; }
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+  std::string_view text_{};
+};
+
+
+// A regular expression compiled to a DFA at compile time, with its tables
+// in static storage, so matching never allocates and never backtracks.
+//
+// Matching works on bytes, and matches are leftmost-longest as with POSIX,
+// rather than std::regex's ECMAScript rule of preferring the first
+// alternative that matches.
+//
+// Unless there is a match right where it starts, search first finds where
+// the earliest match ends, in one pass with a second DFA that lets a match
+// begin at every byte, so a search that finds nothing is linear. Only the
+// positions up to there can start the leftmost match, and each is tried in
+// turn, so the worst case is still quadratic, for patterns that run a long
+// way before failing, like "a*b|c" in "aaaa...ac".
+//
+// static_regex<"[a-z]+=\\d+">::match("answer=42")
+template<regex_pattern Pattern> struct static_regex
+{
+private:
+  static constexpr auto pattern = Pattern.view();
+  static constexpr auto sizes = [] {
+    const auto layout = make_regex_dfa_layout(pattern);
+    return std::array<std::size_t, 2>{ layout.accepts.size(), layout.class_count };
+  }();
+  static constexpr auto anchors = [] {
+    const auto layout = make_regex_dfa_layout(pattern);
+    return std::array<bool, 2>{ layout.anchored_start, layout.anchored_end };
+  }();
+  static constexpr auto search_state_count = [] {
+    // an anchored search only ever tries the start of the text
+    return anchors[0] ? std::size_t{} : make_regex_dfa_layout(pattern, true).accepts.size();
+  }();
+
+public:
+  using state_type = minimal_unsigned_t<sizes[0] - 1>;
+
+  static constexpr auto byte_classes = to_regex_dfa_array<std::uint8_t, 256, 0>(pattern);
+  static constexpr auto transitions = to_regex_dfa_array<state_type, sizes[0] * sizes[1], 1>(pattern);
+  static constexpr auto accepts = to_regex_dfa_array<bool, sizes[0], 2>(pattern);
+  static constexpr std::size_t class_count = sizes[1];
+  static constexpr bool anchored_start = anchors[0];
+  static constexpr bool anchored_end = anchors[1];
+
+  // the search DFA shares byte_classes, and is empty if it was too large
+  using search_state_type = minimal_unsigned_t<(search_state_count == 0 ? 0 : search_state_count - 1)>;
+  static constexpr auto search_transitions =
+    to_regex_dfa_array<search_state_type, search_state_count * sizes[1], 1>(pattern, true);
+  static constexpr auto search_accepts = to_regex_dfa_array<bool, search_state_count, 2>(pattern, true);
+
+  // true if all of str matches
+  [[nodiscard]] static constexpr bool match(const std::string_view str) noexcept
+  {
+    std::size_t state = start_state;
+    for (const auto c : str) {
+      state = next(state, c);
+      if (state == dead_state) { return false; }
+    }
+    return accepts[state];
+  }
+
+  // the leftmost-longest match in str, starting at or after from
+  [[nodiscard]] static constexpr std::optional<std::string_view> search(const std::string_view str,
+    const std::size_t from = 0) noexcept
+  {
+    if (from > str.size() || (anchored_start && from != 0)) { return std::nullopt; }
+    // a match right at from is the common case, and needs no search pass
+    if (const auto length = longest_match_at(str, from)) { return str.substr(from, *length); }
+    if (anchored_start) { return std::nullopt; }
+
+    auto last_start = str.size();
+    if constexpr (search_state_count != 0) {
+      // the leftmost match cannot start after the earliest match ends
+      const auto end = earliest_match_end(str, from + 1);
+      if (!end) { return std::nullopt; }
+      last_start = *end;
+    }
+
+    for (std::size_t start = from + 1; start <= last_start; ++start) {
+      if (const auto length = longest_match_at(str, start)) { return str.substr(start, *length); }
+    }
+    return std::nullopt;
+  }
+
+  // every non-overlapping match, left to right
+  [[nodiscard]] static constexpr regex_match_view<static_regex> find_all(const std::string_view str) noexcept
+  {
+    return regex_match_view<static_regex>{ str };
+  }
+
+private:
+  static constexpr std::size_t dead_state = 0;
+  static constexpr std::size_t start_state = 1;
+
+  [[nodiscard]] static constexpr std::size_t next(const std::size_t state, const char c) noexcept
+  {
+    return transitions[state * class_count + byte_classes[static_cast<unsigned char>(c)]];
+  }
+
+  [[nodiscard]] static constexpr bool accepts_at(const std::size_t state,
+    const std::size_t position,
+    const std::string_view str) noexcept
+  {
+    return accepts[state] && (!anchored_end || position == str.size());
+  }
+
+  // the first position at or after from where any match ends
+  [[nodiscard]] static constexpr std::optional<std::size_t> earliest_match_end(const std::string_view str,
+    const std::size_t from) noexcept
+  {
+    if (from > str.size()) { return std::nullopt; }
+    std::size_t state = start_state;
+    if (search_accepts[state] && (!anchored_end || from == str.size())) { return from; }
+    for (std::size_t position = from; position < str.size(); ++position) {
+      state = search_transitions[state * class_count + byte_classes[static_cast<unsigned char>(str[position])]];
+      if (search_accepts[state] && (!anchored_end || position + 1 == str.size())) { return position + 1; }
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] static constexpr std::optional<std::size_t> longest_match_at(const std::string_view str,
+    const std::size_t start) noexcept
+  {
+    std::optional<std::size_t> result;
+    std::size_t state = start_state;
+    if (accepts_at(state, start, str)) { result = 0; }
+    for (std::size_t position = start; position < str.size(); ++position) {
+      state = next(state, str[position]);
+      if (state == dead_state) { break; }
+      if (accepts_at(state, position + 1, str)) { result = position + 1 - start; }
+    }
+    return result;
+  }
+};
+
+}// namespace lefticus::tools
+
+#endif
@@ -29,21 +29,27 @@ For more information, please refer to <https://unlicense.org>
 #ifndef LEFTICUS_TOOLS_STATIC_VIEWS_HPP
 #define LEFTICUS_TOOLS_STATIC_VIEWS_HPP
 
+#include "inline_string.hpp"
 #include "simple_stack_flat_map.hpp"
 #include "simple_stack_string.hpp"
 #include "simple_stack_vector.hpp"
 #include "utility.hpp"
 #include <algorithm>
 #include <array>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <span>
+#include <stdexcept>
 #include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace lefticus::tools {
 
-// max size object we can convert
-static constexpr std::size_t oversized_size = 10 * 1024;
-
-
 template<typename Value>
 concept is_iterable = requires(const Value &value)
 {
@@ -67,32 +73,17 @@ concept creates_string_like = requires(const Callable &callable)
 };
 
 
-template<typename Value> struct oversized_array
-{
-  std::array<Value, oversized_size> data{};
-  std::size_t size{};
-
-  using value_type = Value;
-
-  constexpr auto begin() const noexcept { return data.begin(); }
-  constexpr auto end() const noexcept { return std::next(data.begin(), static_cast<std::ptrdiff_t>(size)); }
-};
-
-template<typename Data> constexpr auto to_oversized_array(const Data &str)
-{
-  oversized_array<typename Data::value_type> result;
-  std::copy(str.begin(), str.end(), result.data.begin());
-  result.size = str.size();
-  return result;
-}
-
+// Two passes over callable(): the first only lets the size escape the
+// constant evaluation, the second copies straight into an array of exactly
+// that size. callable() is run twice, so it must return the same data each time.
 consteval auto to_right_sized_array(creates_iterable auto callable)
 {
-  constexpr auto oversized = to_oversized_array(callable());
+  constexpr std::size_t size = callable().size();
 
-  using Value_Type = typename std::decay_t<decltype(oversized)>::value_type;
-  std::array<Value_Type, oversized.size> result;
-  std::copy(oversized.begin(), oversized.end(), result.begin());
+  using Value_Type = typename std::decay_t<decltype(callable())>::value_type;
+  std::array<Value_Type, size> result;
+  const auto data = callable();
+  std::copy(data.begin(), data.end(), result.begin());
   return result;
 }
 
@@ -115,6 +106,884 @@ consteval auto to_span(creates_iterable auto callable)
 }
 
 
+// As with callable, comp and proj have to be stateless, lambdas or things
+// like std::ranges::less, so they can be used in constant expressions.
+template<typename Compare, typename Projection>
+consteval auto to_sorted_array(creates_iterable auto callable, Compare comp, Projection proj)
+{
+  auto result = to_right_sized_array(callable);
+  std::ranges::sort(result, comp, proj);
+  return result;
+}
+
+// moves the first of each run of equivalent elements to the front of
+// sorted data, returns how many of those there are
+template<typename Data, typename Compare, typename Projection>
+constexpr std::size_t unique_sorted(Data &data, Compare comp, Projection proj)
+{
+  // data is sorted, so lhs is equivalent to rhs unless it is less
+  const auto equivalent = [comp](const auto &lhs, const auto &rhs) { return !std::invoke(comp, lhs, rhs); };
+  return static_cast<std::size_t>(std::ranges::unique(data, equivalent, proj).begin() - data.begin());
+}
+
+template<typename Compare, typename Projection>
+consteval auto to_sorted_unique_array(creates_iterable auto callable, Compare comp, Projection proj)
+{
+  constexpr auto unique_size = [](auto data, Compare unique_comp, Projection unique_proj) {
+    return unique_sorted(data, unique_comp, unique_proj);
+  }(to_sorted_array(callable, comp, proj), comp, proj);
+
+  auto sorted = to_sorted_array(callable, comp, proj);
+  unique_sorted(sorted, comp, proj);
+
+  using Value_Type = typename std::decay_t<decltype(sorted)>::value_type;
+  std::array<Value_Type, unique_size> result;
+  std::copy_n(sorted.begin(), unique_size, result.begin());
+  return result;
+}
+
+template<creates_iterable Callable, typename Compare = std::ranges::less, typename Projection = std::identity>
+consteval auto to_sorted_span(Callable callable, Compare comp = {}, Projection proj = {})
+{
+  constexpr auto &static_data = make_static<to_sorted_array(callable, comp, proj)>;
+  using Value_Type = typename std::decay_t<decltype(static_data)>::value_type;
+  return std::span<const Value_Type>(static_data.begin(), static_data.end());
+}
+
+template<creates_iterable Callable, typename Compare = std::ranges::less, typename Projection = std::identity>
+consteval auto to_sorted_unique_span(Callable callable, Compare comp = {}, Projection proj = {})
+{
+  constexpr auto &static_data = make_static<to_sorted_unique_array(callable, comp, proj)>;
+  using Value_Type = typename std::decay_t<decltype(static_data)>::value_type;
+  return std::span<const Value_Type>(static_data.begin(), static_data.end());
+}
+
+
+// Binary search over data sorted by comp and proj, normally the result of
+// to_sorted_span or to_sorted_unique_span.
+//
+// lower_bound halves the range without branching on the comparison, so
+// the loop runs exactly log2(size) times and compiles to conditional moves.
+template<typename Value, typename Compare = std::ranges::less, typename Projection = std::identity>
+struct static_lookup
+{
+  using value_type = Value;
+  using size_type = std::size_t;
+
+  constexpr explicit static_lookup(const std::span<const Value> data, Compare comp = {}, Projection proj = {})
+    : data_{ data }, comp_{ comp }, proj_{ proj }
+  {}
+
+  // index of the first element not less than key, size() if there is none
+  template<typename Key> [[nodiscard]] constexpr size_type lower_bound(const Key &key) const
+  {
+    if (data_.empty()) { return 0; }
+
+    const Value *base = data_.data();
+    auto length = data_.size();
+    while (length > 1) {
+      const auto half = length / 2;
+      base = less(base[half - 1], key) ? base + half : base;
+      length -= half;
+    }
+    return static_cast<size_type>(base - data_.data()) + (less(*base, key) ? 1 : 0);
+  }
+
+  // the first element equivalent to key, or nullptr
+  template<typename Key> [[nodiscard]] constexpr const Value *find(const Key &key) const
+  {
+    const auto index = lower_bound(key);
+    if (index == data_.size() || std::invoke(comp_, key, std::invoke(proj_, data_[index]))) { return nullptr; }
+    return &data_[index];
+  }
+
+  template<typename Key> [[nodiscard]] constexpr bool contains(const Key &key) const { return find(key) != nullptr; }
+
+  [[nodiscard]] constexpr std::span<const Value> data() const noexcept { return data_; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return data_.size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return data_.empty(); }
+
+private:
+  template<typename Key> [[nodiscard]] constexpr bool less(const Value &value, const Key &key) const
+  {
+    return std::invoke(comp_, std::invoke(proj_, value), key);
+  }
+
+  std::span<const Value> data_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Projection proj_;
+};
+
+template<typename Value, typename... Param>
+static_lookup(std::span<const Value>, Param...) -> static_lookup<Value, Param...>;
+
+
+// the smallest unsigned type that can hold Max
+template<std::size_t Max>
+using minimal_unsigned_t = std::conditional_t<(Max <= std::numeric_limits<std::uint8_t>::max()),
+  std::uint8_t,
+  std::conditional_t<(Max <= std::numeric_limits<std::uint16_t>::max()),
+    std::uint16_t,
+    std::conditional_t<(Max <= std::numeric_limits<std::uint32_t>::max()), std::uint32_t, std::uint64_t>>>;
+
+// Ragged rows in compressed sparse row form: all of the values back to
+// back, and offsets[i] to offsets[i + 1] is row i. Rows of string-like
+// types come back as string views, anything else as spans.
+template<typename Value, typename Offset, typename Row> struct static_csr
+{
+  using value_type = Row;
+  using size_type = std::size_t;
+  using offset_type = Offset;
+
+  struct iterator
+  {
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+
+    const static_csr *csr{};
+    size_type index{};
+
+    [[nodiscard]] constexpr Row operator*() const { return (*csr)[index]; }
+    constexpr iterator &operator++() noexcept
+    {
+      ++index;
+      return *this;
+    }
+    constexpr iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++index;
+      return result;
+    }
+    [[nodiscard]] constexpr bool operator==(const iterator &) const noexcept = default;
+  };
+
+  std::span<const Value> values;
+  std::span<const Offset> offsets;
+
+  [[nodiscard]] constexpr Row operator[](const size_type row) const noexcept
+  {
+    return Row(values.data() + offsets[row], static_cast<size_type>(offsets[row + 1] - offsets[row]));
+  }
+
+  [[nodiscard]] constexpr Row at(const size_type row) const
+  {
+    if (row >= size()) { throw std::out_of_range("row past end of static_csr"); }
+    return (*this)[row];
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return offsets.size() - 1; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{ this, 0 }; }
+  [[nodiscard]] constexpr iterator end() const noexcept { return iterator{ this, size() }; }
+};
+
+template<typename Rows> constexpr auto csr_sizes(const Rows &rows)
+{
+  pair<std::size_t, std::size_t> result{};
+  for (const auto &row : rows) {
+    ++result.first;
+    result.second += static_cast<std::size_t>(std::distance(row.begin(), row.end()));
+  }
+  return result;
+}
+
+template<typename Value, std::size_t Size> consteval auto to_csr_values(creates_iterable auto callable)
+{
+  std::array<Value, Size> result;
+  auto out = result.begin();
+  for (const auto &row : callable()) { out = std::copy(row.begin(), row.end(), out); }
+  return result;
+}
+
+template<typename Offset, std::size_t Size> consteval auto to_csr_offsets(creates_iterable auto callable)
+{
+  std::array<Offset, Size> result{};
+  std::size_t index = 0;
+  std::size_t offset = 0;
+  for (const auto &row : callable()) {
+    offset += static_cast<std::size_t>(std::distance(row.begin(), row.end()));
+    result[++index] = static_cast<Offset>(offset);
+  }
+  return result;
+}
+
+// Unlike minimized_stackify, which sizes every row for the longest one,
+// this stores exactly as many values as there are, with offsets in the
+// smallest type that fits.
+//
+// callable returns a range of ranges, such as std::vector<std::vector<int>>
+// or std::vector<std::string>
+consteval auto to_csr(creates_iterable auto callable)
+{
+  constexpr auto sizes = csr_sizes(callable());
+
+  using Row_Type = std::decay_t<decltype(*callable().begin())>;
+  using Value_Type = std::decay_t<decltype(*std::declval<const Row_Type &>().begin())>;
+  using Offset_Type = minimal_unsigned_t<sizes.second>;
+
+  constexpr auto &values = make_static<to_csr_values<Value_Type, sizes.second>(callable)>;
+  constexpr auto &offsets = make_static<to_csr_offsets<Offset_Type, sizes.first + 1>(callable)>;
+
+  if constexpr (requires { typename Row_Type::traits_type; }) {
+    return static_csr<Value_Type, Offset_Type, std::basic_string_view<Value_Type>>{ values, offsets };
+  } else {
+    return static_csr<Value_Type, Offset_Type, std::span<const Value_Type>>{ values, offsets };
+  }
+}
+
+
+struct string_table_options
+{
+  // each string is followed by a 0, so c_str() can be used
+  bool null_terminated = false;
+  // equal strings, and strings that are a suffix of another string, are
+  // stored once
+  bool deduplicate = false;
+};
+
+// A range of string_views into one static character blob
+template<typename CharType, typename Offset, typename Length, bool NullTerminated> struct static_string_table
+{
+  using value_type = std::basic_string_view<CharType>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  struct iterator
+  {
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::basic_string_view<CharType>;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+    using pointer = void;
+
+    const static_string_table *table{};
+    difference_type index{};
+
+    [[nodiscard]] constexpr value_type operator*() const { return (*table)[static_cast<size_type>(index)]; }
+    [[nodiscard]] constexpr value_type operator[](const difference_type offset) const { return *(*this + offset); }
+
+    constexpr iterator &operator++() noexcept
+    {
+      ++index;
+      return *this;
+    }
+    constexpr iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++index;
+      return result;
+    }
+    constexpr iterator &operator--() noexcept
+    {
+      --index;
+      return *this;
+    }
+    constexpr iterator operator--(int) noexcept
+    {
+      auto result = *this;
+      --index;
+      return result;
+    }
+    constexpr iterator &operator+=(const difference_type offset) noexcept
+    {
+      index += offset;
+      return *this;
+    }
+    constexpr iterator &operator-=(const difference_type offset) noexcept
+    {
+      index -= offset;
+      return *this;
+    }
+
+    [[nodiscard]] friend constexpr iterator operator+(iterator itr, const difference_type offset) noexcept
+    {
+      return itr += offset;
+    }
+    [[nodiscard]] friend constexpr iterator operator+(const difference_type offset, iterator itr) noexcept
+    {
+      return itr += offset;
+    }
+    [[nodiscard]] friend constexpr iterator operator-(iterator itr, const difference_type offset) noexcept
+    {
+      return itr -= offset;
+    }
+    [[nodiscard]] friend constexpr difference_type operator-(const iterator &lhs, const iterator &rhs) noexcept
+    {
+      return lhs.index - rhs.index;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const iterator &rhs) const noexcept { return index == rhs.index; }
+    [[nodiscard]] constexpr auto operator<=>(const iterator &rhs) const noexcept { return index <=> rhs.index; }
+  };
+
+  using const_iterator = iterator;
+
+  std::basic_string_view<CharType> blob;
+  std::span<const Offset> offsets;
+  std::span<const Length> lengths;
+
+  [[nodiscard]] constexpr value_type operator[](const size_type index) const noexcept
+  {
+    return blob.substr(offsets[index], lengths[index]);
+  }
+
+  [[nodiscard]] constexpr value_type at(const size_type index) const
+  {
+    if (index >= size()) { throw std::out_of_range("index past end of static_string_table"); }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] constexpr const CharType *c_str(const size_type index) const noexcept
+    requires NullTerminated
+  {
+    return blob.data() + offsets[index];
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return offsets.size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return offsets.empty(); }
+
+  [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{ this, 0 }; }
+  [[nodiscard]] constexpr iterator end() const noexcept
+  {
+    return iterator{ this, static_cast<difference_type>(size()) };
+  }
+};
+
+template<typename CharType> struct string_table_layout
+{
+  std::vector<CharType> blob;
+  std::vector<std::size_t> offsets;
+  std::vector<std::size_t> lengths;
+};
+
+template<string_table_options Options, typename Strings> constexpr auto make_string_table_layout(const Strings &strings)
+{
+  using Char_Type = std::decay_t<decltype(*std::declval<const Strings &>().begin()->begin())>;
+  using View_Type = std::basic_string_view<Char_Type>;
+
+  std::vector<View_Type> views;
+  for (const auto &str : strings) { views.emplace_back(str.begin(), str.end()); }
+
+  string_table_layout<Char_Type> layout;
+  layout.offsets.resize(views.size());
+  layout.lengths.resize(views.size());
+
+  const auto place = [&](const std::size_t index) {
+    layout.offsets[index] = layout.blob.size();
+    layout.blob.insert(layout.blob.end(), views[index].begin(), views[index].end());
+    if (Options.null_terminated) { layout.blob.push_back(Char_Type{}); }
+  };
+
+  for (std::size_t index = 0; index < views.size(); ++index) { layout.lengths[index] = views[index].size(); }
+
+  if constexpr (!Options.deduplicate) {
+    for (std::size_t index = 0; index < views.size(); ++index) { place(index); }
+  } else {
+    // Ordered by the reversed strings, a string is a suffix of another one
+    // only if it is a suffix of the one right after it. So going from the
+    // back, each string either fits at the end of the last one placed or
+    // needs to be placed itself.
+    std::vector<std::size_t> order(views.size());
+    for (std::size_t index = 0; index < order.size(); ++index) { order[index] = index; }
+    std::ranges::sort(order, [&](const std::size_t lhs, const std::size_t rhs) {
+      return std::lexicographical_compare(
+        views[lhs].rbegin(), views[lhs].rend(), views[rhs].rbegin(), views[rhs].rend());
+    });
+
+    View_Type last_placed;
+    std::size_t last_placed_end = 0;
+    for (auto itr = order.rbegin(); itr != order.rend(); ++itr) {
+      if (itr != order.rbegin() && last_placed.ends_with(views[*itr])) {
+        layout.offsets[*itr] = last_placed_end - views[*itr].size();
+      } else {
+        place(*itr);
+        last_placed = views[*itr];
+        last_placed_end = layout.offsets[*itr] + last_placed.size();
+      }
+    }
+  }
+
+  return layout;
+}
+
+template<string_table_options Options> constexpr auto string_table_sizes(const auto &strings)
+{
+  const auto layout = make_string_table_layout<Options>(strings);
+
+  std::size_t longest = 0;
+  for (const auto length : layout.lengths) { longest = std::max(longest, length); }
+  return std::array<std::size_t, 3>{ layout.blob.size(), layout.offsets.size(), longest };
+}
+
+template<string_table_options Options, typename Value, std::size_t Size, std::size_t Member>
+consteval auto to_string_table_array(creates_iterable auto callable)
+{
+  const auto layout = make_string_table_layout<Options>(callable());
+  const auto &source = [&]() -> const auto & {
+    if constexpr (Member == 0) {
+      return layout.blob;
+    } else if constexpr (Member == 1) {
+      return layout.offsets;
+    } else {
+      return layout.lengths;
+    }
+  }();
+
+  std::array<Value, Size> result{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    if constexpr (std::is_same_v<Value, typename std::decay_t<decltype(source)>::value_type>) {
+      result[index] = source[index];
+    } else {
+      result[index] = static_cast<Value>(source[index]);
+    }
+  }
+  return result;
+}
+
+// callable returns a range of strings, such as std::vector<std::string>
+//
+// to_string_table<string_table_options{ .null_terminated = true, .deduplicate = true }>(callable)
+template<string_table_options Options = string_table_options{}>
+consteval auto to_string_table(creates_iterable auto callable)
+{
+  constexpr auto sizes = string_table_sizes<Options>(callable());
+  constexpr auto blob_size = sizes[0];
+  constexpr auto count = sizes[1];
+
+  using Char_Type = typename decltype(make_string_table_layout<Options>(callable()).blob)::value_type;
+  using Offset_Type = minimal_unsigned_t<blob_size>;
+  using Length_Type = minimal_unsigned_t<sizes[2]>;
+
+  constexpr auto &blob = make_static<to_string_table_array<Options, Char_Type, blob_size, 0>(callable)>;
+  constexpr auto &offsets = make_static<to_string_table_array<Options, Offset_Type, count, 1>(callable)>;
+  constexpr auto &lengths = make_static<to_string_table_array<Options, Length_Type, count, 2>(callable)>;
+
+  return static_string_table<Char_Type, Offset_Type, Length_Type, Options.null_terminated>{
+    std::basic_string_view<Char_Type>(blob.data(), blob.size()), offsets, lengths
+  };
+}
+
+
+// Result of static_keyword_matcher::longest_prefix
+struct keyword_match
+{
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  // index of the keyword in the list given to to_keyword_matcher, or npos
+  std::size_t keyword = npos;
+  // number of characters matched
+  std::size_t length = 0;
+
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return keyword != npos; }
+};
+
+// A DFA over bytes, made of the trie of the keywords:
+//  * byte_classes maps each byte to a column of transitions, bytes that
+//    behave the same in every state share a column
+//  * transitions[state * class_count + class] is the next state, state 0
+//    is the dead state and state 1 is the start
+//  * accepts[state] is 1 + the index of the keyword ending there, or 0
+template<typename State, typename Accept> struct static_keyword_matcher
+{
+  static constexpr std::size_t npos = keyword_match::npos;
+
+  std::span<const std::uint8_t, 256> byte_classes;
+  std::span<const State> transitions;
+  std::span<const Accept> accepts;
+  std::size_t class_count{};
+
+  // index of the keyword equal to str, or npos
+  [[nodiscard]] constexpr std::size_t match(const std::string_view str) const noexcept
+  {
+    std::size_t state = start_state;
+    for (const auto c : str) {
+      state = next(state, c);
+      if (state == dead_state) { return npos; }
+    }
+    return to_keyword(state);
+  }
+
+  [[nodiscard]] constexpr bool contains(const std::string_view str) const noexcept { return match(str) != npos; }
+
+  // the longest keyword that str starts with
+  [[nodiscard]] constexpr keyword_match longest_prefix(const std::string_view str) const noexcept
+  {
+    keyword_match result{ to_keyword(start_state), 0 };
+    std::size_t state = start_state;
+    for (std::size_t index = 0; index < str.size(); ++index) {
+      state = next(state, str[index]);
+      if (state == dead_state) { break; }
+      if (accepts[state] != 0) { result = keyword_match{ to_keyword(state), index + 1 }; }
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr std::size_t state_count() const noexcept { return accepts.size(); }
+
+private:
+  static constexpr std::size_t dead_state = 0;
+  static constexpr std::size_t start_state = 1;
+
+  [[nodiscard]] constexpr std::size_t next(const std::size_t state, const char c) const noexcept
+  {
+    return transitions[state * class_count + byte_classes[static_cast<unsigned char>(c)]];
+  }
+
+  [[nodiscard]] constexpr std::size_t to_keyword(const std::size_t state) const noexcept
+  {
+    return accepts[state] == 0 ? npos : static_cast<std::size_t>(accepts[state]) - 1;
+  }
+};
+
+struct keyword_matcher_layout
+{
+  std::vector<std::uint8_t> byte_classes;
+  std::vector<std::size_t> transitions;
+  std::vector<std::size_t> accepts;
+  std::size_t class_count{};
+};
+
+template<typename Keywords> constexpr auto make_keyword_matcher_layout(const Keywords &keywords)
+{
+  struct edge
+  {
+    std::size_t from;
+    unsigned char byte;
+    std::size_t to;
+  };
+
+  std::vector<std::string_view> views;
+  for (const auto &keyword : keywords) { views.emplace_back(keyword.begin(), keyword.end()); }
+
+  // sorted, each keyword shares the trie path of its common prefix with
+  // the one before it, so the trie is built without searching for children
+  std::vector<std::size_t> order(views.size());
+  for (std::size_t index = 0; index < order.size(); ++index) { order[index] = index; }
+  std::ranges::sort(order, [&](const std::size_t lhs, const std::size_t rhs) {
+    return views[lhs] < views[rhs] || (views[lhs] == views[rhs] && lhs < rhs);
+  });
+
+  std::vector<edge> edges;
+  std::vector<std::size_t> accepts{ 0, 0 };
+  std::vector<std::size_t> path{ 1 };
+  std::string_view previous;
+  for (const auto index : order) {
+    const auto keyword = views[index];
+    std::size_t common = 0;
+    while (common < keyword.size() && common < previous.size() && keyword[common] == previous[common]) { ++common; }
+
+    path.resize(common + 1);
+    for (std::size_t depth = common; depth < keyword.size(); ++depth) {
+      const auto state = accepts.size();
+      accepts.push_back(0);
+      edges.push_back(edge{ path.back(), static_cast<unsigned char>(keyword[depth]), state });
+      path.push_back(state);
+    }
+
+    // for duplicates the first one wins
+    if (accepts[path.back()] == 0) { accepts[path.back()] = index + 1; }
+    previous = keyword;
+  }
+
+  // bytes with the same (from, to) pairs get the same column, so order the
+  // edges by byte, then by from: two stable counting sorts, which cost far
+  // less of the constexpr evaluation budget than a comparison sort
+  const auto sort_by = [&edges](const auto key, const std::size_t key_count) {
+    std::vector<std::size_t> begin(key_count + 1);
+    for (const auto &transition : edges) { ++begin[key(transition) + 1]; }
+    for (std::size_t index = 0; index < key_count; ++index) { begin[index + 1] += begin[index]; }
+    std::vector<edge> sorted(edges.size());
+    for (const auto &transition : edges) { sorted[begin[key(transition)]++] = transition; }
+    edges = std::move(sorted);
+  };
+  sort_by([](const edge &transition) { return transition.from; }, accepts.size());
+  sort_by([](const edge &transition) { return std::size_t{ transition.byte }; }, 256);// NOLINT Magic Number
+  std::array<std::size_t, 257> byte_begin{};
+  for (const auto &transition : edges) { ++byte_begin[transition.byte + 1U]; }
+  for (std::size_t byte = 0; byte < 256; ++byte) { byte_begin[byte + 1] += byte_begin[byte]; }// NOLINT Magic Number
+
+  const auto same_column = [&](const std::size_t lhs, const std::size_t rhs) {
+    if (byte_begin[lhs + 1] - byte_begin[lhs] != byte_begin[rhs + 1] - byte_begin[rhs]) { return false; }
+    for (std::size_t offset = 0; offset < byte_begin[lhs + 1] - byte_begin[lhs]; ++offset) {
+      const auto &left = edges[byte_begin[lhs] + offset];
+      const auto &right = edges[byte_begin[rhs] + offset];
+      if (left.from != right.from || left.to != right.to) { return false; }
+    }
+    return true;
+  };
+
+  keyword_matcher_layout layout;
+  layout.byte_classes.resize(256);// NOLINT Magic Number
+  std::vector<std::size_t> representatives;
+  for (std::size_t byte = 0; byte < 256; ++byte) {// NOLINT Magic Number
+    std::size_t byte_class = 0;
+    while (byte_class < representatives.size() && !same_column(representatives[byte_class], byte)) { ++byte_class; }
+    if (byte_class == representatives.size()) { representatives.push_back(byte); }
+    layout.byte_classes[byte] = static_cast<std::uint8_t>(byte_class);
+  }
+
+  layout.class_count = representatives.size();
+  layout.transitions.resize(accepts.size() * layout.class_count);
+  for (const auto &transition : edges) {
+    layout.transitions[transition.from * layout.class_count + layout.byte_classes[transition.byte]] = transition.to;
+  }
+  layout.accepts = std::move(accepts);
+  return layout;
+}
+
+template<typename Value, std::size_t Size, std::size_t Member>
+consteval auto to_keyword_matcher_array(creates_iterable auto callable)
+{
+  const auto layout = make_keyword_matcher_layout(callable());
+  const auto &source = [&]() -> const auto & {
+    if constexpr (Member == 0) {
+      return layout.byte_classes;
+    } else if constexpr (Member == 1) {
+      return layout.transitions;
+    } else {
+      return layout.accepts;
+    }
+  }();
+
+  std::array<Value, Size> result{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    if constexpr (std::is_same_v<Value, typename std::decay_t<decltype(source)>::value_type>) {
+      result[index] = source[index];
+    } else {
+      result[index] = static_cast<Value>(source[index]);
+    }
+  }
+  return result;
+}
+
+// callable returns a range of char strings, such as std::vector<std::string>
+consteval auto to_keyword_matcher(creates_iterable auto callable)
+{
+  constexpr auto sizes = [](const auto &layout) {
+    return std::array<std::size_t, 2>{ layout.accepts.size(), layout.class_count };
+  }(make_keyword_matcher_layout(callable()));
+  constexpr auto keyword_count = [](const auto &keywords) {
+    return static_cast<std::size_t>(std::distance(keywords.begin(), keywords.end()));
+  }(callable());
+
+  using State_Type = minimal_unsigned_t<sizes[0] - 1>;
+  using Accept_Type = minimal_unsigned_t<keyword_count>;
+
+  constexpr auto &byte_classes = make_static<to_keyword_matcher_array<std::uint8_t, 256, 0>(callable)>;
+  constexpr auto &transitions =
+    make_static<to_keyword_matcher_array<State_Type, sizes[0] * sizes[1], 1>(callable)>;
+  constexpr auto &accepts = make_static<to_keyword_matcher_array<Accept_Type, sizes[0], 2>(callable)>;
+
+  return static_keyword_matcher<State_Type, Accept_Type>{ byte_classes, transitions, accepts, sizes[1] };
+}
+
+
+// Integers stored as zigzag encoded deltas in LEB128 varints, in blocks of
+// BlockSize values that each start over from 0, so any value can be found
+// by decoding at most one block.
+//
+// Nothing is cached, so every access decodes from the static bytes and is
+// safe to use from any number of threads. Where the whole table is needed
+// repeatedly, decompress() it once into a function local static.
+template<std::integral Value, typename Offset, std::size_t BlockSize> struct static_compressed_span
+{
+  using value_type = Value;
+  using size_type = std::size_t;
+  using offset_type = Offset;
+
+  static constexpr size_type block_size = BlockSize;
+
+  // decodes one value at a time as it advances
+  struct iterator
+  {
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr iterator(const static_compressed_span *span, const size_type index) noexcept
+      : span_{ span }, index_{ index }
+    {
+      if (index_ < span_->size()) {
+        position_ = span_->block_offsets[index_ / BlockSize];
+        current_ = span_->decode(position_, 0);
+      }
+    }
+
+    [[nodiscard]] constexpr Value operator*() const noexcept { return current_; }
+    constexpr iterator &operator++() noexcept
+    {
+      if (++index_ < span_->size()) {
+        current_ = span_->decode(position_, index_ % BlockSize == 0 ? Value{} : current_);
+      }
+      return *this;
+    }
+    constexpr iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++(*this);
+      return result;
+    }
+    [[nodiscard]] constexpr bool operator==(const iterator &rhs) const noexcept { return index_ == rhs.index_; }
+
+  private:
+    const static_compressed_span *span_{};
+    size_type index_{};
+    size_type position_{};
+    Value current_{};
+  };
+
+  std::span<const std::uint8_t> bytes;
+  std::span<const Offset> block_offsets;
+  size_type count{};
+
+  [[nodiscard]] constexpr Value operator[](const size_type index) const noexcept
+  {
+    size_type position = block_offsets[index / BlockSize];
+    Value result{};
+    for (size_type remaining = index % BlockSize + 1; remaining != 0; --remaining) {
+      result = decode(position, result);
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr Value at(const size_type index) const
+  {
+    if (index >= count) { throw std::out_of_range("index past end of static_compressed_span"); }
+    return (*this)[index];
+  }
+
+  // decodes block number block into out, returning the number of values in it
+  constexpr size_type decode_block(const size_type block, const std::span<Value, BlockSize> out) const noexcept
+  {
+    const auto first = block * BlockSize;
+    const auto values = std::min(BlockSize, count - first);
+    size_type position = block_offsets[block];
+    Value previous{};
+    for (size_type index = 0; index < values; ++index) {
+      previous = decode(position, previous);
+      out[index] = previous;
+    }
+    return values;
+  }
+
+  [[nodiscard]] constexpr std::vector<Value> decompress() const { return std::vector<Value>(begin(), end()); }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return count; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+  [[nodiscard]] constexpr size_type block_count() const noexcept { return block_offsets.size() - 1; }
+  // bytes of static storage used, compared to size() * sizeof(Value) uncompressed
+  [[nodiscard]] constexpr size_type compressed_size() const noexcept
+  {
+    return bytes.size() + block_offsets.size() * sizeof(Offset);
+  }
+
+  [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{ this, 0 }; }
+  [[nodiscard]] constexpr iterator end() const noexcept { return iterator{ this, count }; }
+
+private:
+  [[nodiscard]] constexpr Value decode(size_type &position, const Value previous) const noexcept
+  {
+    std::uint64_t zigzag = 0;
+    for (unsigned shift = 0;; shift += 7) {// NOLINT Magic Number
+      const auto byte = bytes[position++];
+      zigzag |= static_cast<std::uint64_t>(byte & 0x7fU) << shift;// NOLINT Magic Number
+      if ((byte & 0x80U) == 0) { break; }// NOLINT Magic Number
+    }
+    const auto delta = (zigzag >> 1U) ^ (~(zigzag & 1U) + 1U);
+    if constexpr (std::is_same_v<Value, std::uint64_t>) {
+      return previous + delta;
+    } else {
+      return static_cast<Value>(static_cast<std::uint64_t>(previous) + delta);
+    }
+  }
+};
+
+template<std::size_t BlockSize, typename Values> constexpr auto make_compressed_layout(const Values &values)
+{
+  pair<std::vector<std::uint8_t>, std::vector<std::size_t>> result;
+  std::uint64_t previous = 0;
+  std::size_t index = 0;
+  for (const auto &value : values) {
+    if (index++ % BlockSize == 0) {
+      result.second.push_back(result.first.size());
+      previous = 0;
+    }
+
+    // sign extended and subtracted modulo 2^64, so any integer type works
+    const auto current = [&]() -> std::uint64_t {
+      if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::uint64_t>) {
+        return value;
+      } else {
+        return static_cast<std::uint64_t>(value);
+      }
+    }();
+    const auto delta = current - previous;
+    previous = current;
+
+    auto zigzag = (delta << 1U) ^ (~(delta >> 63U) + 1U);// NOLINT Magic Number
+    while (zigzag >= 0x80U) {// NOLINT Magic Number
+      result.first.push_back(static_cast<std::uint8_t>((zigzag & 0x7fU) | 0x80U));// NOLINT Magic Number
+      zigzag >>= 7U;// NOLINT Magic Number
+    }
+    result.first.push_back(static_cast<std::uint8_t>(zigzag));
+  }
+  result.second.push_back(result.first.size());
+  return result;
+}
+
+template<std::size_t BlockSize> constexpr auto compressed_sizes(const auto &values)
+{
+  const auto layout = make_compressed_layout<BlockSize>(values);
+  return std::array<std::size_t, 3>{ layout.first.size(),
+    layout.second.size(),
+    static_cast<std::size_t>(std::distance(values.begin(), values.end())) };
+}
+
+template<std::size_t BlockSize, std::size_t Size> consteval auto to_compressed_bytes(creates_iterable auto callable)
+{
+  const auto layout = make_compressed_layout<BlockSize>(callable());
+  std::array<std::uint8_t, Size> result{};
+  std::copy(layout.first.begin(), layout.first.end(), result.begin());
+  return result;
+}
+
+template<std::size_t BlockSize, typename Offset, std::size_t Size>
+consteval auto to_compressed_block_offsets(creates_iterable auto callable)
+{
+  const auto layout = make_compressed_layout<BlockSize>(callable());
+  std::array<Offset, Size> result{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    if constexpr (std::is_same_v<Offset, std::size_t>) {
+      result[index] = layout.second[index];
+    } else {
+      result[index] = static_cast<Offset>(layout.second[index]);
+    }
+  }
+  return result;
+}
+
+// A static table of integers that takes a fraction of the space of
+// to_span when neighbouring values are close together, such as sorted
+// ids, offsets or slowly changing samples. Values are decoded as they are
+// read, see static_compressed_span.
+template<std::size_t BlockSize = 64> consteval auto to_compressed_span(creates_iterable auto callable)
+{
+  static_assert(BlockSize > 0);
+  constexpr auto sizes = compressed_sizes<BlockSize>(callable());
+
+  using Value_Type = std::decay_t<decltype(*callable().begin())>;
+  using Offset_Type = minimal_unsigned_t<sizes[0]>;
+
+  constexpr auto &bytes = make_static<to_compressed_bytes<BlockSize, sizes[0]>(callable)>;
+  constexpr auto &offsets = make_static<to_compressed_block_offsets<BlockSize, Offset_Type, sizes[1]>(callable)>;
+
+  return static_compressed_span<Value_Type, Offset_Type, BlockSize>{ bytes, offsets, sizes[2] };
+}
+
+
 template<std::size_t MaxSize> constexpr auto stackify(auto value) { return value; }
 
 
@@ -129,6 +998,12 @@ template<std::size_t MaxSize, typename CharType> constexpr auto stackify(const s
   return basic_simple_stack_string<CharType, MaxSize>{ string.begin(), string.end() };
 }
 
+template<std::size_t MaxSize, typename CharType, std::size_t InlineCapacity>
+constexpr auto stackify(const basic_inline_string<CharType, InlineCapacity> &string)
+{
+  return basic_simple_stack_string<CharType, MaxSize>{ string.begin(), string.end() };
+}
+
 
 template<std::size_t MaxSize, typename Value> constexpr auto stackify(const std::vector<Value> &vec)
 {
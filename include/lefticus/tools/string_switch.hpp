@@ -0,0 +1,219 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_STRING_SWITCH_HPP
+#define LEFTICUS_TOOLS_STRING_SWITCH_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "hash.hpp"
+#include "simple_stack_string.hpp"
+
+namespace lefticus::tools {
+
+// Maps a string to the index of the matching case, or npos, with a
+// perfect hash built at compile time
+//  * the hash first tries a cheap key made of the length and the first,
+//    middle and last characters, and only falls back to hashing the whole
+//    string when the cheap key cannot tell the cases apart
+//  * a lookup is one hash, one table read and one string compare
+//  * all of the case text is copied in, so cases do not need static
+//    storage duration
+//
+// static constexpr auto commands = make_string_switch("get", "set", "delete");
+// switch (commands(input)) {
+//   case commands.index_of("get"): ...
+//   case commands.index_of("set"): ...
+//   default: ...
+// }
+template<std::size_t Cases, std::size_t TextSize> struct string_switch
+{
+  using index_type = std::conditional_t<(Cases < std::numeric_limits<std::uint8_t>::max()),
+    std::uint8_t,
+    std::conditional_t<(Cases < std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::uint32_t>>;
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  template<typename Range> consteval explicit string_switch(const Range &cases)
+  {
+    std::size_t index = 0;
+    for (const auto &value : cases) {
+      const std::string_view str{ value };
+      for (const auto c : str) { text_[offsets_[index + 1]++] = c; }
+      ++index;
+      if (index < Cases) { offsets_[index + 1] = offsets_[index]; }
+    }
+    if (index != Cases) { throw std::logic_error("number of cases does not match Cases"); }
+
+    for (std::size_t lhs = 0; lhs < Cases; ++lhs) {
+      for (std::size_t rhs = lhs + 1; rhs < Cases; ++rhs) {
+        if (case_at(lhs) == case_at(rhs)) { throw std::logic_error("duplicate case in string_switch"); }
+      }
+    }
+
+    if (!cheap_key_is_unique() || !find_seed(false)) {
+      full_hash_ = true;
+      if (!find_seed(true)) { throw std::logic_error("no perfect hash found for string_switch"); }
+    }
+  }
+
+  [[nodiscard]] constexpr std::size_t operator()(const std::string_view str) const noexcept
+  {
+    const auto index = table_[slot_of(str, full_hash_, seed_)];
+    if (index == empty_slot || case_at(index) != str) { return npos; }
+    return index;
+  }
+
+  // for use in case labels
+  [[nodiscard]] consteval std::size_t index_of(const std::string_view str) const
+  {
+    const auto index = (*this)(str);
+    if (index == npos) { throw std::logic_error("not one of the cases of this string_switch"); }
+    return index;
+  }
+
+  [[nodiscard]] constexpr std::string_view case_at(const std::size_t index) const noexcept
+  {
+    return std::string_view{ text_.data() + offsets_[index], offsets_[index + 1] - offsets_[index] };
+  }
+
+  // cppcheck-suppress functionStatic
+  [[nodiscard]] constexpr static std::size_t size() noexcept { return Cases; }
+
+private:
+  // at least twice the number of cases, so a seed is found quickly
+  static constexpr std::size_t table_bits = [] {
+    std::size_t bits = 0;
+    while ((std::size_t{ 1 } << bits) < Cases * 2) { ++bits; }
+    return bits;
+  }();
+  static constexpr std::size_t table_size = std::size_t{ 1 } << table_bits;
+  static constexpr auto empty_slot = std::numeric_limits<index_type>::max();
+  static constexpr std::uint64_t max_seed_attempts = 100000;
+
+  [[nodiscard]] static constexpr std::uint64_t cheap_key(const std::string_view str) noexcept
+  {
+    if (str.empty()) { return 0; }
+    const auto byte = [&](const std::size_t idx) -> std::uint64_t { return static_cast<unsigned char>(str[idx]); };
+    // NOLINTNEXTLINE Magic Number
+    return str.size() | (byte(0) << 32U) | (byte(str.size() / 2) << 40U) | (byte(str.size() - 1) << 48U);
+  }
+
+  [[nodiscard]] static constexpr std::size_t
+    slot_of(const std::string_view str, const bool full_hash, const std::uint64_t seed) noexcept
+  {
+    if constexpr (table_bits == 0) {
+      return 0;
+    } else {
+      const auto hash = full_hash ? hash_bytes(str, seed) : (cheap_key(str) ^ seed) * 0x9E3779B97F4A7C15ULL;// NOLINT
+      // the high bits of a multiplicative hash are the well mixed ones
+      return static_cast<std::size_t>(hash >> (64U - table_bits));// NOLINT Magic Number
+    }
+  }
+
+  [[nodiscard]] constexpr bool cheap_key_is_unique() const
+  {
+    for (std::size_t lhs = 0; lhs < Cases; ++lhs) {
+      for (std::size_t rhs = lhs + 1; rhs < Cases; ++rhs) {
+        if (cheap_key(case_at(lhs)) == cheap_key(case_at(rhs))) { return false; }
+      }
+    }
+    return true;
+  }
+
+  constexpr bool find_seed(const bool full_hash)
+  {
+    for (std::uint64_t seed = 0; seed < max_seed_attempts; ++seed) {
+      for (auto &slot : table_) { slot = empty_slot; }
+
+      bool collision = false;
+      for (std::size_t index = 0; index < Cases && !collision; ++index) {
+        auto &slot = table_[slot_of(case_at(index), full_hash, seed)];
+        collision = slot != empty_slot;
+        slot = static_cast<index_type>(index);
+      }
+
+      if (!collision) {
+        seed_ = seed;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::array<char, TextSize> text_{};
+  std::array<std::size_t, Cases + 1> offsets_{};
+  std::array<index_type, table_size> table_{};
+  std::uint64_t seed_{};
+  bool full_hash_{};
+};
+
+
+template<typename Value> [[nodiscard]] consteval std::size_t string_switch_text_size()
+{
+  if constexpr (std::is_array_v<Value>) {
+    return std::extent_v<Value> - 1;
+  } else {
+    return Value::total_capacity - 1;
+  }
+}
+
+// cases may be string literals or basic_simple_stack_strings
+template<typename... Strings> [[nodiscard]] consteval auto make_string_switch(const Strings &...strings)
+{
+  return string_switch<sizeof...(Strings), (std::size_t{} + ... + string_switch_text_size<Strings>())>{
+    std::array<std::string_view, sizeof...(Strings)>{ std::string_view{ strings }... }
+  };
+}
+
+// from a callable returning any range of strings, like to_span
+[[nodiscard]] consteval auto to_string_switch(auto callable)
+{
+  constexpr std::size_t cases = [](const auto &values) {
+    std::size_t result = 0;
+    for ([[maybe_unused]] const auto &value : values) { ++result; }
+    return result;
+  }(callable());
+  constexpr std::size_t text_size = [](const auto &values) {
+    std::size_t result = 0;
+    for (const auto &value : values) { result += std::string_view{ value }.size(); }
+    return result;
+  }(callable());
+
+  return string_switch<cases, text_size>{ callable() };
+}
+
+}// namespace lefticus::tools
+
+#endif
@@ -0,0 +1,319 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_UNICODE_HPP
+#define LEFTICUS_TOOLS_UNICODE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+#include "simple_stack_string.hpp"
+
+namespace lefticus::tools {
+
+inline constexpr char32_t replacement_character = U'\xFFFD';
+
+struct decoded_code_point
+{
+  char32_t code_point;
+  // code units consumed, at least 1 even for an invalid sequence
+  std::size_t length;
+  bool valid;
+};
+
+// Decodes the code point starting at pos, the encoding is picked by the
+// size of CharType: UTF-8, UTF-16 or UTF-32.
+//
+// Invalid input decodes to U+FFFD, consuming the maximal subpart of the
+// ill-formed sequence, as recommended by the Unicode standard (3.9).
+template<typename CharType>
+[[nodiscard]] constexpr decoded_code_point decode_code_point(const std::basic_string_view<CharType> str,
+  const std::size_t pos) noexcept
+{
+  if constexpr (sizeof(CharType) == 1) {
+    const auto byte = [&](const std::size_t idx) -> std::uint32_t { return static_cast<unsigned char>(str[idx]); };
+
+    const auto lead = byte(pos);
+    if (lead < 0x80U) { return { static_cast<char32_t>(lead), 1, true }; }// NOLINT Magic Number
+
+    std::size_t length = 0;
+    std::uint32_t code_point = 0;
+    // the allowed range of the first continuation byte, Table 3-7 of the standard
+    std::uint32_t low = 0x80U;// NOLINT Magic Number
+    std::uint32_t high = 0xBFU;// NOLINT Magic Number
+
+    if (lead < 0xC2U) {// NOLINT Magic Number
+      return { replacement_character, 1, false };
+    } else if (lead < 0xE0U) {// NOLINT Magic Number
+      length = 2;
+      code_point = lead & 0x1FU;// NOLINT Magic Number
+    } else if (lead < 0xF0U) {// NOLINT Magic Number
+      length = 3;
+      code_point = lead & 0x0FU;// NOLINT Magic Number
+      if (lead == 0xE0U) { low = 0xA0U; }// NOLINT Magic Number
+      if (lead == 0xEDU) { high = 0x9FU; }// NOLINT Magic Number
+    } else if (lead < 0xF5U) {// NOLINT Magic Number
+      length = 4;
+      code_point = lead & 0x07U;// NOLINT Magic Number
+      if (lead == 0xF0U) { low = 0x90U; }// NOLINT Magic Number
+      if (lead == 0xF4U) { high = 0x8FU; }// NOLINT Magic Number
+    } else {
+      return { replacement_character, 1, false };
+    }
+
+    for (std::size_t idx = 1; idx < length; ++idx) {
+      if (pos + idx >= str.size()) { return { replacement_character, idx, false }; }
+      const auto next = byte(pos + idx);
+      if (next < low || next > high) { return { replacement_character, idx, false }; }
+      code_point = (code_point << 6U) | (next & 0x3FU);// NOLINT Magic Number
+      low = 0x80U;// NOLINT Magic Number
+      high = 0xBFU;// NOLINT Magic Number
+    }
+
+    return { static_cast<char32_t>(code_point), length, true };
+  } else if constexpr (sizeof(CharType) == 2) {
+    const std::uint32_t first = str[pos];
+    if (first < 0xD800U || first > 0xDFFFU) { return { static_cast<char32_t>(first), 1, true }; }// NOLINT
+    if (first > 0xDBFFU || pos + 1 == str.size()) { return { replacement_character, 1, false }; }// NOLINT
+    const std::uint32_t second = str[pos + 1];
+    if (second < 0xDC00U || second > 0xDFFFU) { return { replacement_character, 1, false }; }// NOLINT
+    // NOLINTNEXTLINE Magic Number
+    return { static_cast<char32_t>(0x10000U + ((first - 0xD800U) << 10U) + (second - 0xDC00U)), 2, true };
+  } else {
+    const auto code_point = static_cast<std::uint32_t>(str[pos]);
+    if (code_point > 0x10FFFFU || (code_point >= 0xD800U && code_point <= 0xDFFFU)) {// NOLINT Magic Number
+      return { replacement_character, 1, false };
+    }
+    return { static_cast<char32_t>(code_point), 1, true };
+  }
+}
+
+
+// Returns the offset of the first invalid code unit, or npos if str is
+// entirely valid.
+//
+// At runtime, UTF-8 runs of ASCII are skipped 8 bytes at a time.
+template<typename CharType>
+[[nodiscard]] constexpr std::size_t find_invalid_unicode(const std::basic_string_view<CharType> str) noexcept
+{
+  std::size_t pos = 0;
+  while (pos < str.size()) {
+    if constexpr (sizeof(CharType) == 1) {
+      if (!std::is_constant_evaluated()) {
+        constexpr std::uint64_t high_bits = 0x8080808080808080ULL;
+        while (pos + sizeof(std::uint64_t) <= str.size()) {
+          std::uint64_t block = 0;
+          std::memcpy(&block, str.data() + pos, sizeof(block));
+          if ((block & high_bits) != 0) { break; }
+          pos += sizeof(block);
+        }
+        if (pos == str.size()) { break; }
+      }
+    }
+
+    const auto decoded = decode_code_point(str, pos);
+    if (!decoded.valid) { return pos; }
+    pos += decoded.length;
+  }
+  return std::basic_string_view<CharType>::npos;
+}
+
+template<typename CharType>
+[[nodiscard]] constexpr bool is_valid_unicode(const std::basic_string_view<CharType> str) noexcept
+{
+  return find_invalid_unicode(str) == std::basic_string_view<CharType>::npos;
+}
+
+[[nodiscard]] constexpr bool is_valid_utf8(const std::string_view str) noexcept { return is_valid_unicode(str); }
+[[nodiscard]] constexpr bool is_valid_utf8(const std::u8string_view str) noexcept { return is_valid_unicode(str); }
+
+
+// Forward range of the code points of a UTF-8, UTF-16 or UTF-32 string,
+// invalid sequences show up as U+FFFD
+template<typename CharType> struct code_point_view : std::ranges::view_interface<code_point_view<CharType>>
+{
+  struct iterator
+  {
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char32_t;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr iterator(const std::basic_string_view<CharType> str, const std::size_t pos) noexcept
+      : str_{ str }, pos_{ pos }
+    {
+      decode();
+    }
+
+    [[nodiscard]] constexpr char32_t operator*() const noexcept { return current_; }
+
+    // offset of the current code point in code units
+    [[nodiscard]] constexpr std::size_t position() const noexcept { return pos_; }
+
+    constexpr iterator &operator++() noexcept
+    {
+      pos_ += length_;
+      decode();
+      return *this;
+    }
+
+    constexpr iterator operator++(int) noexcept
+    {
+      auto result = *this;
+      ++(*this);
+      return result;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const iterator &rhs) const noexcept { return pos_ == rhs.pos_; }
+    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept { return pos_ >= str_.size(); }
+
+  private:
+    constexpr void decode() noexcept
+    {
+      if (pos_ < str_.size()) {
+        const auto decoded = decode_code_point(str_, pos_);
+        current_ = decoded.code_point;
+        length_ = decoded.length;
+      }
+    }
+
+    std::basic_string_view<CharType> str_{};
+    std::size_t pos_{};
+    std::size_t length_{};
+    char32_t current_{};
+  };
+
+  constexpr code_point_view() = default;
+  constexpr explicit code_point_view(const std::basic_string_view<CharType> str) noexcept : str_{ str } {}
+
+  [[nodiscard]] constexpr iterator begin() const noexcept { return iterator{ str_, 0 }; }
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+  std::basic_string_view<CharType> str_{};
+};
+
+template<typename CharType>
+[[nodiscard]] constexpr code_point_view<CharType> code_points(const std::basic_string_view<CharType> str) noexcept
+{
+  return code_point_view<CharType>{ str };
+}
+
+template<typename CharType, std::size_t TotalCapacity>
+[[nodiscard]] constexpr code_point_view<CharType> code_points(
+  const basic_simple_stack_string<CharType, TotalCapacity> &str) noexcept
+{
+  return code_point_view<CharType>{ str };
+}
+
+
+// Appends code_point in the encoding of the string's character type,
+// all of the code units are checked against the capacity at once
+template<typename String> constexpr void append_code_point(String &out, const char32_t code_point)
+{
+  using char_type = typename String::value_type;
+  const auto value = static_cast<std::uint32_t>(code_point);
+  std::array<char_type, 4> units{};
+  std::size_t count = 0;
+
+  const auto unit = [&](const std::uint32_t bits) { units[count++] = static_cast<char_type>(bits); };
+
+  if constexpr (sizeof(char_type) == 1) {
+    if (value < 0x80U) {// NOLINT Magic Number
+      unit(value);
+    } else if (value < 0x800U) {// NOLINT Magic Number
+      unit(0xC0U | (value >> 6U));// NOLINT Magic Number
+      unit(0x80U | (value & 0x3FU));// NOLINT Magic Number
+    } else if (value < 0x10000U) {// NOLINT Magic Number
+      unit(0xE0U | (value >> 12U));// NOLINT Magic Number
+      unit(0x80U | ((value >> 6U) & 0x3FU));// NOLINT Magic Number
+      unit(0x80U | (value & 0x3FU));// NOLINT Magic Number
+    } else {
+      unit(0xF0U | (value >> 18U));// NOLINT Magic Number
+      unit(0x80U | ((value >> 12U) & 0x3FU));// NOLINT Magic Number
+      unit(0x80U | ((value >> 6U) & 0x3FU));// NOLINT Magic Number
+      unit(0x80U | (value & 0x3FU));// NOLINT Magic Number
+    }
+  } else if constexpr (sizeof(char_type) == 2) {
+    if (value < 0x10000U) {// NOLINT Magic Number
+      unit(value);
+    } else {
+      unit(0xD800U + ((value - 0x10000U) >> 10U));// NOLINT Magic Number
+      unit(0xDC00U + ((value - 0x10000U) & 0x3FFU));// NOLINT Magic Number
+    }
+  } else {
+    unit(value);
+  }
+
+  out.append(units.data(), count);
+}
+
+// Converts between UTF-8, UTF-16 and UTF-32 strings, invalid input
+// becomes U+FFFD. The capacity of the result is deduced to fit the
+// worst case, so this never throws.
+template<typename ToCharType, std::size_t ToCapacity, typename FromCharType, std::size_t FromCapacity>
+[[nodiscard]] constexpr basic_simple_stack_string<ToCharType, ToCapacity> transcode(
+  const basic_simple_stack_string<FromCharType, FromCapacity> &str)
+{
+  basic_simple_stack_string<ToCharType, ToCapacity> result;
+  for (const auto code_point : code_points(str)) { append_code_point(result, code_point); }
+  return result;
+}
+
+// worst cases: one UTF-16 unit or one invalid UTF-32 unit can become 3 UTF-8 bytes, one UTF-32 unit 4 bytes
+template<typename FromCharType, std::size_t FromCapacity>
+[[nodiscard]] constexpr auto to_utf8(const basic_simple_stack_string<FromCharType, FromCapacity> &str)
+{
+  constexpr std::size_t units_per_unit = sizeof(FromCharType) == 1 ? 3 : (sizeof(FromCharType) == 2 ? 3 : 4);
+  return transcode<char8_t, (FromCapacity - 1) * units_per_unit + 1>(str);
+}
+
+// UTF-8 and UTF-16 never need more UTF-16 units than they have code units
+template<typename FromCharType, std::size_t FromCapacity>
+[[nodiscard]] constexpr auto to_utf16(const basic_simple_stack_string<FromCharType, FromCapacity> &str)
+{
+  constexpr std::size_t units_per_unit = sizeof(FromCharType) == 4 ? 2 : 1;
+  return transcode<char16_t, (FromCapacity - 1) * units_per_unit + 1>(str);
+}
+
+template<typename FromCharType, std::size_t FromCapacity>
+[[nodiscard]] constexpr auto to_utf32(const basic_simple_stack_string<FromCharType, FromCapacity> &str)
+{
+  return transcode<char32_t, FromCapacity>(str);
+}
+
+}// namespace lefticus::tools
+
+#endif
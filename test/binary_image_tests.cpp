@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/binary_image.hpp>
+#include <lefticus/tools/flat_map.hpp>
+#include <lefticus/tools/static_views.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <filesystem>
+#include <unistd.h>
+#endif
+
+using lefticus::tools::image_storable;
+using lefticus::tools::serialize_image;
+using lefticus::tools::view_image;
+
+namespace {
+using table_type = lefticus::tools::simple_stack_flat_map<lefticus::tools::simple_stack_string<8>, int, 4>;
+
+// built at compile time, GCC 12 at -O2 can drop the last store into the
+// returned table when this runs as an ordinary call
+constexpr table_type make_table()
+{
+  table_type result;
+  result["one"] = 1;
+  result["two"] = 2;
+  result["three"] = 3;
+  return result;
+}
+}// namespace
+
+
+TEST_CASE("[binary_image] only fixed-layout types can be stored")
+{
+  STATIC_REQUIRE(image_storable<int>);
+  STATIC_REQUIRE(image_storable<lefticus::tools::simple_stack_vector<double, 10>>);
+  STATIC_REQUIRE(image_storable<lefticus::tools::simple_stack_string<10>>);
+  STATIC_REQUIRE(image_storable<lefticus::tools::pair<int, char>>);
+  STATIC_REQUIRE(image_storable<table_type>);
+  STATIC_REQUIRE(!image_storable<std::string>);
+  STATIC_REQUIRE(!image_storable<std::vector<int>>);
+  STATIC_REQUIRE(!image_storable<int *>);
+}
+
+TEST_CASE("[binary_image] layout hash depends on the type and capacity")
+{
+  using lefticus::tools::image_layout;
+  using lefticus::tools::simple_stack_vector;
+  STATIC_REQUIRE(image_layout<int>::hash != image_layout<unsigned int>::hash);
+  STATIC_REQUIRE(image_layout<int>::hash != image_layout<float>::hash);
+  STATIC_REQUIRE(image_layout<simple_stack_vector<int, 4>>::hash != image_layout<simple_stack_vector<int, 5>>::hash);
+  STATIC_REQUIRE(
+    image_layout<simple_stack_vector<int, 4>>::hash != image_layout<lefticus::tools::simple_stack_string<4>>::hash);
+}
+
+TEST_CASE("[binary_image] round trip")
+{
+  constexpr auto table = make_table();
+  const auto image = serialize_image(table);
+  REQUIRE(image.size() == lefticus::tools::image_size<table_type>);
+
+  const auto &viewed = view_image<table_type>(image);
+  REQUIRE(static_cast<const void *>(&viewed) != static_cast<const void *>(&table));
+  REQUIRE(viewed.size() == 3);
+  REQUIRE(viewed.at("two") == 2);
+  REQUIRE(viewed.at("three") == 3);
+}
+
+TEST_CASE("[binary_image] round trip of a stackified value")
+{
+  constexpr auto data = lefticus::tools::minimized_stackify<32>([] {
+    lefticus::tools::flat_map<std::string, lefticus::tools::flat_map<std::string, std::vector<int>>> result;
+    result["hello"]["world"].push_back(42);
+    result["hello"]["jason"].push_back(72);
+    result["bye"]["world"].push_back(1);
+    return result;
+  });
+
+  const auto image = serialize_image(data);
+  const auto &viewed = view_image<std::remove_cvref_t<decltype(data)>>(image);
+  REQUIRE(viewed.at("hello").at("jason").at(0) == 72);
+  REQUIRE(viewed.at("bye").at("world").at(0) == 1);
+}
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_clear_padding)
+TEST_CASE("[binary_image] padding inside the value is cleared")
+{
+  using padded = lefticus::tools::pair<char, std::uint32_t>;
+  STATIC_REQUIRE(sizeof(padded) == 8);
+
+  padded value{};
+  std::memset(&value, 0xff, sizeof(value));// NOLINT Magic Number
+  value.first = 'a';
+  value.second = 1;
+
+  const auto image = serialize_image(value);
+  const auto offset = lefticus::tools::image_value_offset<padded>;
+  CHECK(image[offset] == std::byte{ 'a' });
+  for (std::size_t index = 1; index < alignof(std::uint32_t); ++index) { CHECK(image[offset + index] == std::byte{}); }
+  CHECK(view_image<padded>(image).second == 1);
+}
+#endif
+#endif
+
+TEST_CASE("[binary_image] rejects bad images")
+{
+  constexpr auto table = make_table();
+  const auto image = serialize_image(table);
+  const std::span<const std::byte> bytes{ image };
+
+  REQUIRE_THROWS_AS(view_image<int>(bytes), std::runtime_error);
+  REQUIRE_THROWS_AS(view_image<table_type>(bytes.first(bytes.size() - 1)), std::runtime_error);
+  REQUIRE_THROWS_AS(view_image<table_type>(bytes.first(8)), std::runtime_error);
+
+  auto corrupted = image;
+  corrupted[0] = std::byte{ 'X' };
+  REQUIRE_THROWS_AS(view_image<table_type>(corrupted), std::runtime_error);
+
+  auto swapped = image;
+  std::swap(swapped[12], swapped[15]);
+  REQUIRE_THROWS_AS(view_image<table_type>(swapped), std::runtime_error);
+}
+
+#if __has_include(<sys/mman.h>)
+TEST_CASE("[binary_image] mapped from a file")
+{
+  // one file per process, the test executables can run in parallel
+  const auto path = std::filesystem::temp_directory_path()
+                    / ("lefticus_tools_binary_image_test_" + std::to_string(::getpid()) + ".bin");
+  {
+    constexpr auto table = make_table();
+    const auto image = serialize_image(table);
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(image.data()),// NOLINT (writing bytes)
+      static_cast<std::streamsize>(image.size()));
+  }
+
+  {
+    lefticus::tools::mapped_image<table_type> mapped{ path };
+    REQUIRE(mapped->size() == 3);
+    REQUIRE(mapped->at("one") == 1);
+
+    auto moved = std::move(mapped);
+    REQUIRE((*moved).at("three") == 3);
+  }
+
+  REQUIRE_THROWS_AS(lefticus::tools::mapped_image<int>{ path }, std::runtime_error);
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(lefticus::tools::mapped_image<table_type>{ path }, std::runtime_error);
+}
+#endif
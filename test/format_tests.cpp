@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/format.hpp>
+
+#include <cstdint>
+#include <string>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+TEST_CASE("[format] literal text and escapes")
+{
+  CONSTEXPR auto str = lefticus::tools::format_stack<32>("{{hello}} world");
+  STATIC_REQUIRE(str == "{hello} world");
+}
+
+TEST_CASE("[format] strings and chars")
+{
+  CONSTEXPR auto sv = std::string_view{ "name" };
+  CONSTEXPR auto sss = lefticus::tools::simple_stack_string<8>{ "value" };
+  CONSTEXPR auto str = lefticus::tools::format_stack<32>("{}={} [{}] {}", sv, sss, 'x', "done");
+  STATIC_REQUIRE(str == "name=value [x] done");
+
+  const std::string runtime_string{ "runtime" };
+  CHECK(lefticus::tools::format_stack<32>("<{}>", runtime_string) == "<runtime>");
+}
+
+TEST_CASE("[format] integers and bools")
+{
+  CONSTEXPR auto str = lefticus::tools::format_stack<128>("{} {} {} {} {} {}",
+    0,
+    -42,// NOLINT Magic Number
+    std::numeric_limits<std::int64_t>::min(),
+    std::numeric_limits<std::uint64_t>::max(),
+    std::uint8_t{ 255 },// NOLINT Magic Number
+    true);
+  STATIC_REQUIRE(str == "0 -42 -9223372036854775808 18446744073709551615 255 true");
+
+  // runtime path goes through std::to_chars
+  const auto value = GENERATE(0, 1, -1, 12345, -2147483647);// NOLINT Magic Number
+  CHECK(lefticus::tools::format_stack<32>("{}", value) == std::to_string(value));
+}
+
+TEST_CASE("[format] floating point at runtime")
+{
+  CHECK(lefticus::tools::format_stack<32>("{} {}", 1.5, 0.25F) == "1.5 0.25");// NOLINT Magic Number
+}
+
+TEST_CASE("[format] int_np and strong_alias")
+{
+  struct meters_tag
+  {
+  };
+  using meters = lefticus::tools::strong_alias<int, meters_tag>;
+
+  CONSTEXPR auto str =
+    lefticus::tools::format_stack<32>("{} {}", lefticus::tools::int_np<std::int16_t>::from(-7), meters{ 12 });// NOLINT
+  STATIC_REQUIRE(str == "-7 12");
+}
+
+TEST_CASE("[format] format_to appends")
+{
+  const auto format = []() {
+    lefticus::tools::simple_stack_string<32> str{ "count: " };
+    lefticus::tools::format_to(str, "{}/{}", 3, 4);
+    return str;
+  };
+
+  CONSTEXPR auto str = format();
+  STATIC_REQUIRE(str == "count: 3/4");
+}
+
+TEST_CASE("[format] overflow throws or truncates")
+{
+  lefticus::tools::simple_stack_string<8> str;
+  CHECK_THROWS_AS(lefticus::tools::format_to(str, "{}{}", "abcd", 123456), std::length_error);
+
+  const auto truncate = []() {
+    lefticus::tools::simple_stack_string<8> result;
+    const bool fit = lefticus::tools::format_to_truncated(result, "{}{}", "abcd", 123456);// NOLINT Magic Number
+    return std::pair{ fit, result };
+  };
+
+  CONSTEXPR auto truncated = truncate();
+  STATIC_REQUIRE(truncated.first == false);
+  STATIC_REQUIRE(truncated.second == "abcd123");
+
+  lefticus::tools::simple_stack_string<8> fits;
+  CHECK(lefticus::tools::format_to_truncated(fits, "{}", 1234567));// NOLINT Magic Number
+  CHECK(fits == "1234567");
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/hash.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+TEST_CASE("[hash] hash_bytes matches the wyhash final version 4 test vectors")
+{
+  // reference output of wyhash(msg, len, seed = index, _wyp)
+  STATIC_REQUIRE(lefticus::tools::hash_bytes("", 0) == 0x93228a4de0eec5a2ULL);
+  STATIC_REQUIRE(lefticus::tools::hash_bytes("a", 1) == 0xc5bac3db178713c4ULL);
+  STATIC_REQUIRE(lefticus::tools::hash_bytes("abc", 2) == 0xa97f2f7b1d9b3314ULL);
+  STATIC_REQUIRE(lefticus::tools::hash_bytes("message digest", 3) == 0x786d1f1df3801df4ULL);// NOLINT Magic Number
+  STATIC_REQUIRE(
+    lefticus::tools::hash_bytes("abcdefghijklmnopqrstuvwxyz", 4) == 0xdca5a8138ad37c87ULL);// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::hash_bytes("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 5)
+                 == 0xb9e734f117cfaf70ULL);// NOLINT Magic Number
+  STATIC_REQUIRE(
+    lefticus::tools::hash_bytes(
+      "12345678901234567890123456789012345678901234567890123456789012345678901234567890", 6)// NOLINT Magic Number
+    == 0x6cc5eab49a92d617ULL);// NOLINT Magic Number
+
+  // the runtime path reads with unaligned loads, it must agree too
+  const std::string runtime_input{ "12345678901234567890123456789012345678901234567890123456789012345678901234567890" };
+  CHECK(lefticus::tools::hash_bytes(runtime_input, 6) == 0x6cc5eab49a92d617ULL);// NOLINT Magic Number
+}
+
+TEST_CASE("[hash] hash_bytes is usable at compile time and matches runtime")
+{
+  CONSTEXPR auto empty = lefticus::tools::hash_bytes("");
+  CONSTEXPR auto short_string = lefticus::tools::hash_bytes("abc");
+  CONSTEXPR auto medium_string = lefticus::tools::hash_bytes("0123456789abcdef0123");
+  CONSTEXPR auto long_string = lefticus::tools::hash_bytes(
+    "The quick brown fox jumps over the lazy dog, and then the lazy dog gets up and chases the fox");
+
+  STATIC_REQUIRE(empty != short_string);
+  STATIC_REQUIRE(short_string != medium_string);
+  STATIC_REQUIRE(medium_string != long_string);
+
+  // the runtime path uses unaligned loads instead of assembling bytes
+  const std::string runtime_long{
+    "The quick brown fox jumps over the lazy dog, and then the lazy dog gets up and chases the fox"
+  };
+  CHECK(lefticus::tools::hash_bytes(runtime_long) == long_string);
+  CHECK(lefticus::tools::hash_bytes(std::string{ "abc" }) == short_string);
+}
+
+TEST_CASE("[hash] every length and every byte matters")
+{
+  // exercise each of the size classes of the algorithm
+  std::string input;
+  std::unordered_set<std::uint64_t> seen;
+  for (std::size_t length = 0; length < 200; ++length) {// NOLINT Magic Number
+    CHECK(seen.insert(lefticus::tools::hash_bytes(input)).second);
+    input.push_back(static_cast<char>('a' + length % 26));// NOLINT Magic Number
+  }
+
+  std::string flipped = input;
+  for (std::size_t idx = 0; idx < flipped.size(); ++idx) {
+    flipped[idx] = static_cast<char>(flipped[idx] ^ 1);
+    CHECK(lefticus::tools::hash_bytes(flipped) != lefticus::tools::hash_bytes(input));
+    flipped[idx] = input[idx];
+  }
+}
+
+TEST_CASE("[hash] seed changes the result")
+{
+  STATIC_REQUIRE(lefticus::tools::hash_bytes("abc", 1) != lefticus::tools::hash_bytes("abc", 2));
+  STATIC_REQUIRE(lefticus::tools::hash_integer(42, 1) != lefticus::tools::hash_integer(42, 2));// NOLINT Magic Number
+}
+
+TEST_CASE("[hash] wide strings hash all of their bytes")
+{
+  CONSTEXPR auto wide = lefticus::tools::hash_string(std::u16string_view{ u"ĀȀ" });
+  CONSTEXPR auto narrow = lefticus::tools::hash_bytes(std::string_view{ "\x00\x01\x00\x02", 4 });
+  STATIC_REQUIRE(wide == narrow);
+}
+
+TEST_CASE("[hash] hasher agrees across string types")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<16> sss{ "hello" };
+  STATIC_REQUIRE(lefticus::tools::hasher{}(sss) == lefticus::tools::hasher{}(std::string_view{ "hello" }));
+  STATIC_REQUIRE(lefticus::tools::hasher{}("hello") == lefticus::tools::hasher{}(std::string_view{ "hello" }));
+  CHECK(lefticus::tools::hasher{}(std::string{ "hello" }) == lefticus::tools::hasher{}(sss));
+  CHECK(std::hash<lefticus::tools::simple_stack_string<16>>{}(sss) == lefticus::tools::hasher{}(sss));
+}
+
+TEST_CASE("[hash] hasher mixes integers")
+{
+  STATIC_REQUIRE(lefticus::tools::hasher{}(1) != 1);
+  STATIC_REQUIRE(lefticus::tools::hasher{}(-1) == lefticus::tools::hasher{}(std::int64_t{ -1 }));
+  STATIC_REQUIRE(
+    lefticus::tools::hasher{}(lefticus::tools::int_np<std::uint8_t>::from(3)) == lefticus::tools::hasher{}(3));
+}
+
+TEST_CASE("[hash] hasher handles pairs and ranges")
+{
+  STATIC_REQUIRE(lefticus::tools::hasher{}(std::pair{ 1, 2 }) != lefticus::tools::hasher{}(std::pair{ 2, 1 }));
+
+  CONSTEXPR lefticus::tools::simple_stack_vector<int, 8> vec{ 1, 2, 3 };
+  CONSTEXPR lefticus::tools::simple_stack_vector<int, 8> empty{};
+  STATIC_REQUIRE(lefticus::tools::hasher{}(vec) != lefticus::tools::hasher{}(empty));
+  CHECK(lefticus::tools::hasher{}(vec) == lefticus::tools::hasher{}(std::vector<int>{ 1, 2, 3 }));
+}
+
+TEST_CASE("[hash] std::hash specializations work with unordered containers")
+{
+  std::unordered_map<lefticus::tools::simple_stack_string<16>, int> names;
+  names[lefticus::tools::simple_stack_string<16>{ "one" }] = 1;
+  names[lefticus::tools::simple_stack_string<16>{ "two" }] = 2;
+  CHECK(names.at(lefticus::tools::simple_stack_string<16>{ "two" }) == 2);
+
+  std::unordered_set<lefticus::tools::simple_stack_vector<int, 4>> vectors;
+  vectors.insert(lefticus::tools::simple_stack_vector<int, 4>{ 1, 2 });
+  CHECK(vectors.contains(lefticus::tools::simple_stack_vector<int, 4>{ 1, 2 }));
+  CHECK(!vectors.contains(lefticus::tools::simple_stack_vector<int, 4>{ 2, 1 }));
+
+  std::unordered_set<lefticus::tools::int_np<int>> ints;
+  ints.insert(lefticus::tools::int_np<int>{ 5 });// NOLINT Magic Number
+  CHECK(ints.contains(lefticus::tools::int_np<int>{ 5 }));// NOLINT Magic Number
+
+  std::unordered_set<std::pair<int, int>, lefticus::tools::hasher> pairs;
+  pairs.insert(std::pair{ 1, 2 });
+  CHECK(pairs.contains(std::pair{ 1, 2 }));
+
+  std::unordered_set<lefticus::tools::pair<int, int>> tools_pairs;
+  tools_pairs.insert(lefticus::tools::pair{ 1, 2 });
+  CHECK(tools_pairs.contains(lefticus::tools::pair{ 1, 2 }));
+  CHECK(!tools_pairs.contains(lefticus::tools::pair{ 2, 1 }));
+  CHECK(std::hash<lefticus::tools::pair<int, int>>{}(lefticus::tools::pair{ 1, 2 })
+        == lefticus::tools::hasher{}(std::pair{ 1, 2 }));
+}
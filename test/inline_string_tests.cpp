@@ -0,0 +1,163 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/inline_string.hpp>
+#include <lefticus/tools/static_views.hpp>
+
+#include <string>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+// inline_string holds a pointer to itself, so the objects are built and
+// inspected within a single constant evaluation
+
+TEST_CASE("[inline_string] short strings stay inline")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "hello" };
+    return str.is_inline() && str.size() == 5 && str.capacity() == 7 && str == "hello";
+  }());
+
+  STATIC_REQUIRE(sizeof(lefticus::tools::inline_string<24>) == 24 + 3 * sizeof(void *));
+}
+
+TEST_CASE("[inline_string] long strings spill to the heap")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "hello" };
+    str.append(" world, this is long");
+    return !str.is_inline() && str == "hello world, this is long" && str.c_str()[str.size()] == '\0';
+  }());
+
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<4> str;
+    for (char c = 'a'; c <= 'z'; ++c) { str.push_back(c); }
+    return str.size() == 26 && str.front() == 'a' && str.back() == 'z' && str.capacity() >= 26;
+  }());
+}
+
+TEST_CASE("[inline_string] shrink_to_fit moves back inline")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "a string too long to be inline" };
+    str.erase(3);
+    const bool was_inline = str.is_inline();
+    str.shrink_to_fit();
+    return !was_inline && str.is_inline() && str == "a s";
+  }());
+}
+
+TEST_CASE("[inline_string] copies and moves")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> heap{ "longer than eight characters" };
+    lefticus::tools::inline_string<8> small{ "short" };
+
+    auto heap_copy = heap;
+    auto small_copy = small;
+    auto heap_moved = std::move(heap_copy);
+    auto small_moved = std::move(small_copy);
+
+    lefticus::tools::inline_string<8> assigned;
+    assigned = heap;
+    assigned = small;
+
+    return heap_moved == heap && small_moved == small && heap_copy.empty() && small_copy.empty()// NOLINT
+           && small_moved.is_inline() && !heap_moved.is_inline() && assigned == "short";
+  }());
+}
+
+TEST_CASE("[inline_string] edits across the inline boundary")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "world" };
+    str.insert(0, "hello ");
+    str.replace(0, 5, "goodbye");
+    str.insert(str.size(), 3, '!');
+    return str == "goodbye world!!!" && str.find("world") == 8 && str.rfind('!') == 15 && str.starts_with("good")
+           && str.ends_with('!') && str.contains("bye") && str.compare("goodbye") > 0;
+  }());
+
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<4> str;
+    str.resize(10, 'x');
+    str.resize(2);
+    return str == "xx";
+  }());
+}
+
+TEST_CASE("[inline_string] sources inside the string itself")
+{
+  // each of these moves the string from the inline buffer to the heap,
+  // freeing or shifting the characters being copied from
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "abcdef" };
+    str += str;
+    str += str;
+    return !str.is_inline() && str == "abcdefabcdefabcdefabcdef";
+  }());
+
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "abcdef" };
+    str.append(str.data() + 2, 3);
+    str.append(str.data(), str.size());
+    return str == "abcdefcdeabcdefcde";
+  }());
+
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "a string that lives on the heap" };
+    str.assign(str.view().substr(2, 6));
+    const bool assigned = str == "string";
+    str = str.view().substr(1);
+    return assigned && str == "tring";
+  }());
+
+  STATIC_REQUIRE([] {
+    lefticus::tools::inline_string<8> str{ "abcdef" };
+    str.insert(2, str.view());
+    str.replace(0, 1, str.view().substr(6));
+    return str == "efcdefbabcdefcdef";
+  }());
+
+  const auto runtime = [] {
+    lefticus::tools::inline_string<8> str{ "abcdef" };
+    str += str;
+    str += str;
+    str.insert(0, str.view().substr(24));
+    str.assign(str.view().substr(3, 4));
+    return std::string{ str.view() };
+  };
+  CHECK(runtime() == "defa");
+}
+
+TEST_CASE("[inline_string] compares with std::string and simple_stack_string")
+{
+  const lefticus::tools::inline_string<4> str{ "a runtime string" };
+  const std::string std_str{ "a runtime string" };
+  CHECK(str == std_str);
+  CHECK(std_str == str);
+  CHECK(str == std::string_view{ "a runtime string" });
+  CHECK(lefticus::tools::simple_stack_string<32>{ "a runtime string" } == str);
+  CHECK(str != "a different string");
+  CHECK_THROWS_AS(str.at(100), std::out_of_range);// NOLINT Magic Number
+}
+
+TEST_CASE("[inline_string] stackify")
+{
+  const auto make_data = [] {
+    std::vector<lefticus::tools::inline_string<4>> result;
+    result.emplace_back("short");
+    result.emplace_back("a much longer string");
+    return result;
+  };
+
+  CONSTEXPR auto minimized = lefticus::tools::minimized_stackify<32>(make_data);// NOLINT Magic Number
+
+  STATIC_REQUIRE(minimized.size() == 2);
+  STATIC_REQUIRE(minimized[1] == std::string_view{ "a much longer string" });
+  STATIC_REQUIRE(minimized[1].capacity() == 20);
+}
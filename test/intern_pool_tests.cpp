@@ -0,0 +1,91 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/intern_pool.hpp>
+
+#include <string>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+TEST_CASE("[intern_pool] ids are dense and stable")
+{
+  lefticus::tools::intern_pool pool;
+  CHECK(pool.empty());
+
+  CHECK(pool.intern("cpu") == 0);
+  CHECK(pool.intern("memory") == 1);
+  CHECK(pool.intern("cpu") == 0);
+  CHECK(pool.intern("") == 2);
+  CHECK(pool.size() == 3);
+
+  CHECK(pool[0] == "cpu");
+  CHECK(pool[1] == "memory");
+  CHECK(pool[2].empty());
+  CHECK(pool.text() == "cpumemory");
+  CHECK_THROWS_AS(pool.at(3), std::out_of_range);
+}
+
+TEST_CASE("[intern_pool] find does not insert")
+{
+  lefticus::tools::intern_pool pool;
+  pool.intern("a");
+  CHECK(pool.find("a") == 0U);
+  CHECK(!pool.find("b").has_value());
+  CHECK(!pool.contains("b"));
+  CHECK(pool.size() == 1);
+}
+
+TEST_CASE("[intern_pool] grows to hold many strings")
+{
+  lefticus::tools::intern_pool pool;
+  for (std::uint32_t idx = 0; idx < 1000; ++idx) {// NOLINT Magic Number
+    CHECK(pool.intern("name_" + std::to_string(idx)) == idx);
+  }
+  for (std::uint32_t idx = 0; idx < 1000; ++idx) {// NOLINT Magic Number
+    CHECK(pool.find("name_" + std::to_string(idx)) == idx);
+    CHECK(pool[idx] == "name_" + std::to_string(idx));
+  }
+}
+
+constexpr auto well_known_names()
+{
+  lefticus::tools::simple_stack_intern_pool<32, 4> pool;// NOLINT Magic Number
+  pool.intern("cpu");
+  pool.intern("memory");
+  pool.intern("disk");
+  return pool;
+}
+
+TEST_CASE("[intern_pool] fixed capacity pool is usable at compile time")
+{
+  CONSTEXPR auto names = well_known_names();
+  STATIC_REQUIRE(names.size() == 3);
+  STATIC_REQUIRE(names.find("memory") == 1U);
+  STATIC_REQUIRE(names[2] == "disk");
+  STATIC_REQUIRE(!names.contains("network"));
+}
+
+TEST_CASE("[intern_pool] fixed capacity pool reports overflow without changing")
+{
+  auto names = well_known_names();
+  names.intern("gpu");
+  CHECK_THROWS_AS(names.intern("network"), std::length_error);
+  CHECK(names.size() == 4);
+  CHECK(!names.contains("network"));
+
+  lefticus::tools::simple_stack_intern_pool<4, 4> small;
+  CHECK_THROWS_AS(small.intern("too long"), std::length_error);
+  CHECK(small.empty());
+}
+
+TEST_CASE("[intern_pool] runtime pool can be seeded from a compile time pool")
+{
+  static constexpr auto names = well_known_names();
+  lefticus::tools::intern_pool pool{ names };
+  CHECK(pool.find("disk") == names.find("disk"));
+  CHECK(pool.intern("network") == 3);
+}
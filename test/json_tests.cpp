@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/flat_map.hpp>
+#include <lefticus/tools/json.hpp>
+#include <lefticus/tools/static_views.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using lefticus::tools::parse_json;
+
+#if __cpp_lib_constexpr_string >= 201907L && __cpp_lib_constexpr_vector >= 201907L
+namespace {
+constexpr std::string_view config_source = R"({
+  "servers": {
+    "primary": [ 8080, 8081 ],
+    "backup": [ 9090 ]
+  },
+  "limits": { "retries": [3], "empty": [] }
+})";
+
+using config_type = lefticus::tools::flat_map<std::string,
+  lefticus::tools::flat_map<std::string, std::vector<int>>>;
+}// namespace
+
+TEST_CASE("[json] scalars")
+{
+  STATIC_REQUIRE(parse_json<bool>("true"));
+  STATIC_REQUIRE(!parse_json<bool>(" false "));
+  STATIC_REQUIRE(parse_json<int>("-42") == -42);
+  STATIC_REQUIRE(parse_json<std::int8_t>("-128") == -128);
+  STATIC_REQUIRE(parse_json<std::uint64_t>("18446744073709551615") == 18446744073709551615ULL);
+  STATIC_REQUIRE(parse_json<double>("3.14") == 3.14);// NOLINT Magic Number
+  STATIC_REQUIRE(parse_json<double>("-0.5e2") == -50.0);// NOLINT Magic Number
+  STATIC_REQUIRE(parse_json<double>("1E-3") == 0.001);// NOLINT Magic Number
+  STATIC_REQUIRE(parse_json<double>("1e308") > 1e307);// NOLINT Magic Number
+  STATIC_REQUIRE(parse_json<double>("1e-400") == 0.0);
+  STATIC_REQUIRE(parse_json<float>("0.25") == 0.25F);// NOLINT Magic Number
+  STATIC_REQUIRE(parse_json<std::optional<int>>("null") == std::nullopt);
+  STATIC_REQUIRE(parse_json<std::optional<int>>("7") == 7);// NOLINT Magic Number
+}
+
+TEST_CASE("[json] strings")
+{
+  STATIC_REQUIRE(parse_json<std::string>(R"("a\"b\\c\/d\n")") == "a\"b\\c/d\n");
+  STATIC_REQUIRE(parse_json<std::string>(R"("é€")") == "é€");
+  STATIC_REQUIRE(parse_json<std::string>(R"("😀")") == "\U0001F600");
+  STATIC_REQUIRE(parse_json<std::u32string>(R"("xé)" "€\"") == U"xé€");
+  STATIC_REQUIRE(parse_json<lefticus::tools::simple_stack_string<8>>(R"("short")") == "short");
+}
+
+TEST_CASE("[json] objects and arrays")
+{
+  constexpr auto check = [] {
+    const auto config = parse_json<config_type>(config_source);
+    return config.size() == 2 && config.at("servers").at("primary") == std::vector<int>{ 8080, 8081 }// NOLINT
+           && config.at("limits").at("empty").empty();
+  };
+  STATIC_REQUIRE(check());
+
+  STATIC_REQUIRE(parse_json<std::vector<std::vector<int>>>("[[1],[],[2,3]]").size() == 3);
+}
+
+TEST_CASE("[json] minimized_stackify gives right-sized static configuration")
+{
+  CONSTEXPR auto config =
+    lefticus::tools::minimized_stackify<32>([]() { return parse_json<config_type>(config_source); });
+
+  STATIC_REQUIRE(config.max_size() == 2);
+  STATIC_REQUIRE(config.at("servers").max_size() == 2);
+  STATIC_REQUIRE(config.at("servers").at("primary").capacity() == 2);
+  STATIC_REQUIRE(config.at("servers").at("backup")[0] == 9090);// NOLINT Magic Number
+  STATIC_REQUIRE(config.at("limits").at("retries")[0] == 3);
+}
+
+TEST_CASE("[json] rejects invalid input")
+{
+  CHECK_THROWS_AS(parse_json<int>(""), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<int>("01"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<int>("1.5"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<int>("1 2"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::int8_t>("128"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<unsigned>("-1"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<double>("1."), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<double>("1e400"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<double>("-1e400"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<float>("1e39"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<bool>("True"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::string>("\"\xff\xfe\""), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::string>("\"\xc3\""), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::string>("\"\xed\xa0\x80\""), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::u32string>("\"\xff\""), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::u16string>("\"a\x80\""), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::string>(R"("abc)"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::string>(R"("\x")"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::string>(R"("\ud83d")"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::vector<int>>("[1,]"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::vector<int>>("[1"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<config_type>(R"({"a":{}, "a":{}})"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<std::vector<std::vector<std::vector<int>>>>("[[[[]]]]"), std::invalid_argument);
+  CHECK_THROWS_AS(parse_json<lefticus::tools::simple_stack_string<2>>(R"("long")"), std::length_error);
+}
+#endif
@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/simple_stack_pool.hpp>
+#include <lefticus/tools/utility.hpp>
+
+#include <iterator>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+constexpr inline std::size_t POOL_SIZE = 8;
+
+TEST_CASE("[simple_stack_pool] starts empty")
+{
+  STATIC_REQUIRE(lefticus::tools::simple_stack_pool<int, POOL_SIZE>{}.empty() == true);
+  STATIC_REQUIRE(lefticus::tools::simple_stack_pool<int, POOL_SIZE>::capacity() == POOL_SIZE);
+}
+
+TEST_CASE("[simple_stack_pool] uses the smallest index type")
+{
+  STATIC_REQUIRE(sizeof(lefticus::tools::simple_stack_pool<int, POOL_SIZE>::handle) == sizeof(std::uint16_t));
+  STATIC_REQUIRE(sizeof(lefticus::tools::simple_stack_pool<char, 70000>::handle) == sizeof(std::uint32_t));
+}
+
+TEST_CASE("[simple_stack_pool] acquire constructs objects in place")
+{
+  const auto create = []() {
+    lefticus::tools::simple_stack_pool<lefticus::tools::pair<int, int>, POOL_SIZE> pool;
+    auto *first = pool.acquire(1, 2);
+    auto *second = pool.acquire(3, 4);
+    second->second = 5;// NOLINT Magic Number
+    return lefticus::tools::pair{ pool.size(), first->first + second->second };
+  };
+
+  CONSTEXPR auto result = create();
+  STATIC_REQUIRE(result.first == 2);
+  STATIC_REQUIRE(result.second == 6);
+}
+
+TEST_CASE("[simple_stack_pool] release reuses slots")
+{
+  const auto reuse = []() {
+    lefticus::tools::simple_stack_pool<int, POOL_SIZE> pool;
+    [[maybe_unused]] auto *first = pool.acquire(1);
+    auto *second = pool.acquire(2);
+    pool.release(second);
+    auto *third = pool.acquire(3);
+    return third == second && pool.size() == 2;
+  };
+
+  STATIC_REQUIRE(reuse());
+}
+
+TEST_CASE("[simple_stack_pool] handles refer to objects")
+{
+  const auto use_handles = []() {
+    lefticus::tools::simple_stack_pool<int, POOL_SIZE> pool;
+    [[maybe_unused]] const auto first = pool.acquire_handle(1);
+    const auto second = pool.acquire_handle(2);
+    pool[second] += 40;// NOLINT Magic Number
+    const bool same_handle = pool.handle_of(&pool.at(second)) == second;
+    pool.release(second);
+    return same_handle && !pool.is_live(second) ? pool.at(first) : 0;
+  };
+
+  STATIC_REQUIRE(use_handles() == 1);
+}
+
+TEST_CASE("[simple_stack_pool] iterates over live objects only")
+{
+  const auto sum_live = []() {
+    lefticus::tools::simple_stack_pool<int, POOL_SIZE> pool;
+    auto *one = pool.acquire(1);
+    [[maybe_unused]] auto *two = pool.acquire(2);
+    auto *three = pool.acquire(3);
+    [[maybe_unused]] auto *four = pool.acquire(4);
+    pool.release(one);
+    pool.release(three);
+
+    int sum = 0;
+    for (const auto value : pool) { sum += value; }
+    return lefticus::tools::pair{ sum, std::distance(pool.begin(), pool.end()) };
+  };
+
+  CONSTEXPR auto result = sum_live();
+  STATIC_REQUIRE(result.first == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(result.second == 2);
+}
+
+TEST_CASE("[simple_stack_pool] throws when capacity is exceeded")
+{
+  lefticus::tools::simple_stack_pool<int, 2> pool;
+  auto *first = pool.acquire(1);
+  [[maybe_unused]] auto *second = pool.acquire(2);
+  REQUIRE_THROWS_AS(pool.acquire(3), std::length_error);
+
+  pool.release(first);
+  REQUIRE_THROWS_AS(pool.release(first), std::invalid_argument);
+  REQUIRE(pool.acquire(4) == first);
+}
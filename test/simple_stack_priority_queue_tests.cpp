@@ -0,0 +1,91 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/simple_stack_priority_queue.hpp>
+#include <lefticus/tools/simple_stack_vector.hpp>
+
+#include <functional>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+constexpr inline std::size_t QUEUE_SIZE = 16;
+
+template<typename Queue> constexpr auto drain(Queue queue)
+{
+  lefticus::tools::simple_stack_vector<typename Queue::value_type, Queue::capacity()> result;
+  while (!queue.empty()) {
+    result.push_back(queue.top());
+    queue.pop();
+  }
+  return result;
+}
+
+TEST_CASE("[simple_stack_priority_queue] starts empty")
+{
+  STATIC_REQUIRE(lefticus::tools::simple_stack_priority_queue<int, QUEUE_SIZE>{}.empty() == true);
+}
+
+TEST_CASE("[simple_stack_priority_queue] pops in priority order")
+{
+  const auto create = []() {
+    lefticus::tools::simple_stack_priority_queue<int, QUEUE_SIZE> queue;
+    for (const auto value : { 5, 1, 9, 3, 7, 2, 8, 6, 4, 0 }) { queue.push(value); }
+    return queue;
+  };
+
+  CONSTEXPR auto queue = create();
+  STATIC_REQUIRE(queue.size() == 10);
+  STATIC_REQUIRE(queue.top() == 9);
+  STATIC_REQUIRE(drain(queue)
+                 == lefticus::tools::simple_stack_vector<int, QUEUE_SIZE>{ 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 });
+}
+
+TEST_CASE("[simple_stack_priority_queue] arity and comparison are configurable")
+{
+  const auto create = []() {
+    lefticus::tools::simple_stack_priority_queue<int, QUEUE_SIZE, std::greater<>, 2> queue;
+    for (const auto value : { 5, 1, 9, 3, 7, 2, 8, 6, 4, 0 }) { queue.emplace(value); }
+    return drain(queue);
+  };
+
+  STATIC_REQUIRE(create() == lefticus::tools::simple_stack_vector<int, QUEUE_SIZE>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+}
+
+TEST_CASE("[simple_stack_priority_queue] replace_top is pop then push")
+{
+  const auto create = []() {
+    lefticus::tools::simple_stack_priority_queue<int, QUEUE_SIZE> queue;
+    for (const auto value : { 5, 1, 9, 3 }) { queue.push(value); }
+    queue.replace_top(4);
+    return drain(queue);
+  };
+
+  STATIC_REQUIRE(create() == lefticus::tools::simple_stack_vector<int, QUEUE_SIZE>{ 5, 4, 3, 1 });
+}
+
+TEST_CASE("[simple_stack_priority_queue] push_bounded keeps the top K")
+{
+  const auto top_k = []() {
+    // min-heap, so top() is the smallest of the largest 4 seen
+    lefticus::tools::simple_stack_priority_queue<int, 4, std::greater<>> queue;
+    for (const auto value : { 5, 1, 9, 3, 7, 2, 8, 6, 4, 0 }) { queue.push_bounded(value); }
+    return drain(queue);
+  };
+
+  STATIC_REQUIRE(top_k() == lefticus::tools::simple_stack_vector<int, 4>{ 6, 7, 8, 9 });
+}
+
+TEST_CASE("[simple_stack_priority_queue] push_bounded reports dropped values")
+{
+  lefticus::tools::simple_stack_priority_queue<int, 2, std::greater<>> queue;
+  REQUIRE(queue.push_bounded(5));
+  REQUIRE(queue.push_bounded(6));
+  REQUIRE(queue.full());
+  REQUIRE_FALSE(queue.push_bounded(1));
+  REQUIRE(queue.push_bounded(7));
+  REQUIRE(queue.top() == 6);
+  REQUIRE_THROWS_AS(queue.push(8), std::length_error);
+}
@@ -1,6 +1,11 @@
 #include <catch2/catch.hpp>
 #include <lefticus/tools/simple_stack_string.hpp>
 
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 #ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
 #define CONSTEXPR
 #else
@@ -104,7 +109,8 @@ TEST_CASE("[simple_stack_string] reverse iterators work")
 TEST_CASE("[simple_stack_string] simple_stack_string + char string literal")
 {
   CONSTEXPR lefticus::tools::simple_stack_string<10> str{ "Hello" };
-  CONSTEXPR auto hello_world = str + " World";
+  CONSTEXPR lefticus::tools::basic_simple_stack_string hello_world = str + " World";
+  STATIC_REQUIRE(hello_world == "Hello World");
   STATIC_REQUIRE(hello_world.size() == 11);
   STATIC_REQUIRE(hello_world.capacity() == 15);
 }
@@ -113,7 +119,8 @@ TEST_CASE("[simple_stack_string] simple_stack_string + char string literal")
 TEST_CASE("[simple_stack_string] char string literal + simple_stack_string")
 {
   CONSTEXPR lefticus::tools::simple_stack_string<10> str{ " World" };
-  CONSTEXPR auto hello_world = "Hello" + str;
+  CONSTEXPR lefticus::tools::basic_simple_stack_string hello_world = "Hello" + str;
+  STATIC_REQUIRE(hello_world == "Hello World");
   STATIC_REQUIRE(hello_world.size() == 11);
   STATIC_REQUIRE(hello_world.capacity() == 14);
 }
@@ -122,7 +129,8 @@ TEST_CASE("[simple_stack_string] simple_stack_string + simple_stack_string")
 {
   CONSTEXPR lefticus::tools::simple_stack_string<10> str1{ "Hello" };
   CONSTEXPR lefticus::tools::simple_stack_string<10> str2{ " World" };
-  CONSTEXPR auto hello_world = str1 + str2;
+  CONSTEXPR lefticus::tools::basic_simple_stack_string hello_world = str1 + str2;
+  STATIC_REQUIRE(hello_world == "Hello World");
   STATIC_REQUIRE(hello_world.size() == 11);
   STATIC_REQUIRE(hello_world.capacity() == 18);
 }
@@ -148,7 +156,7 @@ TEST_CASE("[simple_stack_string] to_sss")
 TEST_CASE("[simple_stack_string] to_sss + to_sss")
 {
   using namespace lefticus::tools::literals;
-  CONSTEXPR auto str1 = to_sss("Hello") + to_sss(" World");
+  CONSTEXPR lefticus::tools::basic_simple_stack_string str1 = to_sss("Hello") + to_sss(" World");
   STATIC_REQUIRE(str1.size() == 11);
   STATIC_REQUIRE(str1.capacity() == 11);
   STATIC_REQUIRE(decltype(str1)::total_capacity == 12);
@@ -168,3 +176,347 @@ TEST_CASE("[simple_stack_string] simple_stack_string == const char *, const char
   STATIC_REQUIRE(to_sss("Hello") == "Hello");
   STATIC_REQUIRE("Hello" == to_sss("Hello"));
 }
+
+TEST_CASE("[simple_stack_string] can be created from forward iterators")
+{
+  CONSTEXPR auto sv = std::string_view{ "abcd" };
+  CONSTEXPR auto str = lefticus::tools::simple_stack_string<5>{ sv.begin(), sv.end() };
+  STATIC_REQUIRE(str == "abcd");
+  STATIC_REQUIRE(str.data()[4] == '\0');
+
+  CHECK_THROWS_AS((lefticus::tools::simple_stack_string<4>{ sv.begin(), sv.end() }), std::length_error);
+}
+
+TEST_CASE("[simple_stack_string] push_back stops at capacity")
+{
+  lefticus::tools::simple_stack_string<3> str;
+  str.push_back('a');
+  str.push_back('b');
+  CHECK(str == "ab");
+  CHECK_THROWS_AS(str.push_back('c'), std::length_error);
+  CHECK_THROWS_AS(str.resize(3), std::length_error);
+}
+
+TEST_CASE("[simple_stack_string] append")
+{
+  const auto append = []() {
+    lefticus::tools::simple_stack_string<17> str{ "Hello" };
+    str.append(std::string_view{ ", " });
+    str.append("World!!", 5);// NOLINT Magic Number
+    str.append(3, '!');
+    str += '?';
+    return str;
+  };
+
+  CONSTEXPR auto str = append();
+  STATIC_REQUIRE(str == "Hello, World!!!?");
+  STATIC_REQUIRE(str.data()[str.size()] == '\0');
+
+  lefticus::tools::simple_stack_string<6> small{ "Hello" };
+  CHECK_THROWS_AS(small.append(std::string_view{ "!" }), std::length_error);
+  CHECK_THROWS_AS(small.append(1, '!'), std::length_error);
+  CHECK(small == "Hello");
+}
+
+TEST_CASE("[simple_stack_string] operator+= and operator= take wide strings")
+{
+  const auto append = []() {
+    lefticus::tools::basic_simple_stack_string<wchar_t, 10> str;
+    str = std::wstring_view{ L"abc" };
+    str += std::wstring_view{ L"def" };
+    return str;
+  };
+
+  CONSTEXPR auto str = append();
+  STATIC_REQUIRE(str == std::wstring_view{ L"abcdef" });
+}
+
+TEST_CASE("[simple_stack_string] assign")
+{
+  const auto assign = []() {
+    lefticus::tools::simple_stack_string<12> str{ "Hello World" };
+    str.assign(std::string_view{ "abc" });
+    auto result = str;
+    result.assign(2, 'x');
+    result.append(str);
+    return result;
+  };
+
+  CONSTEXPR auto str = assign();
+  STATIC_REQUIRE(str == "xxabc");
+  STATIC_REQUIRE(str.data()[str.size()] == '\0');
+}
+
+TEST_CASE("[simple_stack_string] insert")
+{
+  const auto insert = []() {
+    lefticus::tools::simple_stack_string<16> str{ "Hed" };
+    str.insert(2, std::string_view{ "llo Worl" });
+    str.insert(0, 2, '>');
+    str.insert(str.size(), "!!", 1);
+    return str;
+  };
+
+  CONSTEXPR auto str = insert();
+  STATIC_REQUIRE(str == ">>Hello World!");
+  STATIC_REQUIRE(str.data()[str.size()] == '\0');
+
+  lefticus::tools::simple_stack_string<6> small{ "Hello" };
+  CHECK_THROWS_AS(small.insert(6, std::string_view{}), std::out_of_range);
+  CHECK_THROWS_AS(small.insert(0, 1, '>'), std::length_error);
+  CHECK(small == "Hello");
+}
+
+TEST_CASE("[simple_stack_string] erase and replace")
+{
+  const auto edit = []() {
+    lefticus::tools::simple_stack_string<16> str{ "Hello World" };
+    str.erase(5, 1);// NOLINT Magic Number
+    str.replace(0, 5, std::string_view{ "Goodbye" });// NOLINT Magic Number
+    str.replace(7, 5, std::string_view{ "!" });// NOLINT Magic Number
+    str.erase(4);
+    return str;
+  };
+
+  CONSTEXPR auto str = edit();
+  STATIC_REQUIRE(str == "Good");
+  STATIC_REQUIRE(str.data()[str.size()] == '\0');
+
+  lefticus::tools::simple_stack_string<6> small{ "Hello" };
+  small.erase();
+  CHECK(small.empty());
+  CHECK_THROWS_AS(small.erase(1), std::out_of_range);
+}
+
+TEST_CASE("[simple_stack_string] sources inside the string itself")
+{
+  const auto append = []() {
+    lefticus::tools::simple_stack_string<32> str{ "abcdef" };
+    str.append(str.data() + 2, 3);
+    str += str;
+    return str;
+  };
+  CONSTEXPR auto appended = append();
+  STATIC_REQUIRE(appended == "abcdefcdeabcdefcde");
+
+  const auto insert = []() {
+    lefticus::tools::simple_stack_string<16> str{ "abcd" };
+    str.insert(0, std::string_view(str.data() + 2, 2));
+    str.insert(2, std::string_view(str));
+    return str;
+  };
+  CONSTEXPR auto inserted = insert();
+  STATIC_REQUIRE(inserted == "cdcdabcdabcd");
+
+  const auto replace = []() {
+    lefticus::tools::simple_stack_string<16> str{ "abcdef" };
+    str.replace(1, 2, str.data() + 3, 3);
+    str.replace(0, 4, std::string_view(str).substr(5));// NOLINT Magic Number
+    return str;
+  };
+  CONSTEXPR auto replaced = replace();
+  STATIC_REQUIRE(replaced == "efdef");
+
+  const auto assign = []() {
+    lefticus::tools::simple_stack_string<16> str{ "Hello World" };
+    str.assign(std::string_view(str).substr(6));// NOLINT Magic Number
+    str = std::string_view(str).substr(1);
+    return str;
+  };
+  CONSTEXPR auto assigned = assign();
+  STATIC_REQUIRE(assigned == "orld");
+  STATIC_REQUIRE(assigned.data()[assigned.size()] == '\0');
+
+  const auto runtime = [] {
+    lefticus::tools::simple_stack_string<16> str{ "abcd" };
+    str.insert(0, std::string_view(str.data() + 2, 2));
+    const std::string after_insert{ std::string_view(str) };
+    str.replace(0, 2, std::string_view(str).substr(4));
+    return after_insert + "," + std::string{ std::string_view(str) };
+  };
+  CHECK(runtime() == "cdabcd,cdabcd");
+}
+
+TEST_CASE("[simple_stack_string] find")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<32> str{ "abcabcabd" };
+  using sss = decltype(str);
+
+  STATIC_REQUIRE(str.find('c') == 2);
+  STATIC_REQUIRE(str.find('c', 3) == 5);// NOLINT Magic Number
+  STATIC_REQUIRE(str.find('z') == sss::npos);
+  STATIC_REQUIRE(str.find('a', 100) == sss::npos);// NOLINT Magic Number
+
+  STATIC_REQUIRE(str.find(std::string_view{ "abd" }) == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(str.find(std::string_view{ "bca" }, 2) == 4);// NOLINT Magic Number
+  STATIC_REQUIRE(str.find(std::string_view{ "abcabcabdx" }) == sss::npos);
+  STATIC_REQUIRE(str.find(std::string_view{}) == 0);
+  STATIC_REQUIRE(str.find(std::string_view{}, 9) == 9);// NOLINT Magic Number
+  STATIC_REQUIRE(str.find(std::string_view{}, 10) == sss::npos);// NOLINT Magic Number
+}
+
+TEST_CASE("[simple_stack_string] rfind")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<32> str{ "abcabcabd" };
+  using sss = decltype(str);
+
+  STATIC_REQUIRE(str.rfind('a') == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(str.rfind('a', 5) == 3);// NOLINT Magic Number
+  STATIC_REQUIRE(str.rfind('a', 0) == 0);
+  STATIC_REQUIRE(str.rfind('z') == sss::npos);
+  STATIC_REQUIRE(sss{}.rfind('a') == sss::npos);
+
+  STATIC_REQUIRE(str.rfind(std::string_view{ "abc" }) == 3);
+  STATIC_REQUIRE(str.rfind(std::string_view{ "abc" }, 2) == 0);
+  STATIC_REQUIRE(str.rfind(std::string_view{ "abd" }) == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(str.rfind(std::string_view{ "xyz" }) == sss::npos);
+  STATIC_REQUIRE(str.rfind(std::string_view{}) == 9);// NOLINT Magic Number
+}
+
+TEST_CASE("[simple_stack_string] find_first_of")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<32> str{ "key=value;other" };
+  using sss = decltype(str);
+
+  STATIC_REQUIRE(str.find_first_of(std::string_view{ ";=" }) == 3);
+  STATIC_REQUIRE(str.find_first_of(std::string_view{ ";=" }, 4) == 9);// NOLINT Magic Number
+  STATIC_REQUIRE(str.find_first_of(std::string_view{ "=" }) == 3);
+  STATIC_REQUIRE(str.find_first_of('=') == 3);
+  STATIC_REQUIRE(str.find_first_of(std::string_view{ "!?" }) == sss::npos);
+  STATIC_REQUIRE(str.find_first_of(std::string_view{}) == sss::npos);
+
+  CONSTEXPR lefticus::tools::basic_simple_stack_string<wchar_t, 32> wide{ L"key=value;other" };
+  STATIC_REQUIRE(wide.find_first_of(std::wstring_view{ L";=" }, 4) == 9);// NOLINT Magic Number
+}
+
+TEST_CASE("[simple_stack_string] find_first_of handles high bit characters")
+{
+  const lefticus::tools::simple_stack_string<8> str{ "ab\xff\x80" };
+  CHECK(str.find_first_of(std::string_view{ "\x80\xff" }) == 2);
+  CHECK(str.find_first_of(std::string_view{ "\x80z" }) == 3);
+}
+
+TEST_CASE("[simple_stack_string] searches agree with std::string_view on long strings")
+{
+  // long enough to go through the 8 characters at a time paths, with
+  // every byte value, including the ones with the high bit set
+  lefticus::tools::simple_stack_string<600> str;// NOLINT Magic Number
+  for (std::size_t idx = 0; idx < str.capacity(); ++idx) {
+    str.push_back(static_cast<char>((idx * 37U + idx / 256U) % 256U));// NOLINT Magic Number
+  }
+  const std::string_view view{ str };
+
+  for (const char c : { '\0', '\x7f', '\x80', '\xff', 'a', '\x01' }) {
+    for (const std::size_t pos : { std::size_t{ 0 }, std::size_t{ 7 }, std::size_t{ 300 }, std::size_t{ 599 } }) {
+      CHECK(str.rfind(c, pos) == view.rfind(c, pos));
+    }
+    const std::array<char, 3> chars{ c, static_cast<char>(c + 1), '\x80' };
+    for (const std::size_t pos : { std::size_t{ 0 }, std::size_t{ 5 }, std::size_t{ 301 }, std::size_t{ 599 } }) {
+      for (const std::size_t count : { std::size_t{ 2 }, std::size_t{ 3 } }) {
+        const std::string_view set{ chars.data(), count };
+        CHECK(str.find_first_of(set, pos) == view.find_first_of(set, pos));
+      }
+    }
+  }
+
+  CHECK(str.find_first_of(std::string_view{ "\x80\x81" }, 600) == decltype(str)::npos);// NOLINT Magic Number
+}
+
+TEST_CASE("[simple_stack_string] starts_with, ends_with, contains")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<32> str{ "Hello World" };
+
+  STATIC_REQUIRE(str.starts_with(std::string_view{ "Hello" }));
+  STATIC_REQUIRE(str.starts_with('H'));
+  STATIC_REQUIRE(!str.starts_with(std::string_view{ "World" }));
+  STATIC_REQUIRE(!str.starts_with(std::string_view{ "Hello World!" }));
+  STATIC_REQUIRE(str.starts_with(std::string_view{}));
+
+  STATIC_REQUIRE(str.ends_with(std::string_view{ "World" }));
+  STATIC_REQUIRE(str.ends_with('d'));
+  STATIC_REQUIRE(!str.ends_with(std::string_view{ "Hello" }));
+  STATIC_REQUIRE(!lefticus::tools::simple_stack_string<4>{}.ends_with('d'));
+
+  STATIC_REQUIRE(str.contains(std::string_view{ "o W" }));
+  STATIC_REQUIRE(str.contains('W'));
+  STATIC_REQUIRE(!str.contains(std::string_view{ "ow" }));
+}
+
+TEST_CASE("[simple_stack_string] compare")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<32> str{ "abc" };
+
+  STATIC_REQUIRE(str.compare(std::string_view{ "abc" }) == 0);
+  STATIC_REQUIRE(str.compare(std::string_view{ "abd" }) < 0);
+  STATIC_REQUIRE(str.compare(std::string_view{ "abb" }) > 0);
+  STATIC_REQUIRE(str.compare(std::string_view{ "ab" }) > 0);
+  STATIC_REQUIRE(str.compare(std::string_view{ "abcd" }) < 0);
+}
+
+TEST_CASE("[simple_stack_string] simple_stack_string == simple_stack_string")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<8> str1{ "Hello" };
+  CONSTEXPR lefticus::tools::simple_stack_string<16> str2{ "Hello" };
+  CONSTEXPR lefticus::tools::simple_stack_string<16> str3{ "Help" };
+  STATIC_REQUIRE(str1 == str2);
+  STATIC_REQUIRE(!(str2 == str3));
+}
+
+TEST_CASE("[simple_stack_string] chained operator+ deduces the summed capacity")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<8> first{ "Hello" };
+  CONSTEXPR lefticus::tools::simple_stack_string<4> separator{ ", " };
+  CONSTEXPR lefticus::tools::basic_simple_stack_string result = first + separator + "World!" + separator;
+  STATIC_REQUIRE(result == "Hello, World!, ");
+  STATIC_REQUIRE(decltype(result)::total_capacity == 8 + 4 + 7 + 4 - 3);
+  STATIC_REQUIRE(result.data()[result.size()] == '\0');
+}
+
+TEST_CASE("[simple_stack_string] operator+ expression can be inspected and converted")
+{
+  const auto concat = []() {
+    const lefticus::tools::simple_stack_string<8> lhs{ "abc" };
+    const auto expression = lhs + "def";
+    lefticus::tools::simple_stack_string<32> larger = expression;
+    larger += expression.str();
+    return std::pair{ expression.size(), larger };
+  };
+
+  CONSTEXPR auto result = concat();
+  STATIC_REQUIRE(result.first == 6);
+  STATIC_REQUIRE(result.second == "abcdefabcdef");
+}
+
+TEST_CASE("[simple_stack_string] operator+ expression compares like a string")
+{
+  CONSTEXPR lefticus::tools::simple_stack_string<8> lhs{ "ab" };
+  CONSTEXPR lefticus::tools::simple_stack_string<8> rhs{ "cd" };
+  CONSTEXPR lefticus::tools::simple_stack_string<8> abcd{ "abcd" };
+
+  STATIC_REQUIRE((lhs + rhs) == "abcd");
+  STATIC_REQUIRE("abcd" == (lhs + rhs));
+  STATIC_REQUIRE((lhs + rhs) != "abdc");
+  STATIC_REQUIRE((lhs + rhs) != "abc");
+  STATIC_REQUIRE((lhs + rhs) == abcd);
+  STATIC_REQUIRE(abcd == (lhs + rhs));
+  STATIC_REQUIRE((lhs + rhs) == std::string_view{ "abcd" });
+  STATIC_REQUIRE((lhs + "" + rhs) == (lhs + rhs));
+  STATIC_REQUIRE((lhs + rhs) != (rhs + lhs));
+  STATIC_REQUIRE(lhs + rhs + lhs == "abcdab");
+  CHECK((lhs + rhs) == std::string{ "abcd" });
+
+  // it has no storage to view, str() owns the characters
+  STATIC_REQUIRE(!std::is_convertible_v<decltype(lhs + rhs), std::string_view>);
+  STATIC_REQUIRE(std::string_view{ (lhs + rhs).str() }.size() == 4);
+}
+
+TEST_CASE("[simple_stack_string] operator+ with temporaries")
+{
+  using namespace lefticus::tools::literals;
+  const auto concat = []() -> lefticus::tools::simple_stack_string<16> {
+    return to_sss("one") + to_sss(" two") + lefticus::tools::simple_stack_string<8>{ " three" };
+  };
+
+  CONSTEXPR auto result = concat();
+  STATIC_REQUIRE(result == "one two three");
+}
@@ -137,3 +137,30 @@ TEST_CASE("[simple_stack_vector] end / cend work")
 
   STATIC_REQUIRE(get_size_from_iterators() == 3);
 }
+
+TEST_CASE("[simple_stack_vector] data() points at the first element")
+{
+  const auto sum_through_data = []() {
+    lefticus::tools::simple_stack_vector<int, STACK_SIZE> vec{ 1, 2, 3 };
+    const auto *data = vec.data();
+    return data[0] + data[1] + data[2];
+  };
+
+  STATIC_REQUIRE(sum_through_data() == 6);// NOLINT Magic Number
+}
+
+TEST_CASE("[simple_stack_vector] resize value initializes new elements")
+{
+  const auto create = []() {
+    lefticus::tools::simple_stack_vector<int, STACK_SIZE> vec{ 1, 2, 3 };
+    vec.resize(1);
+    vec.resize(4);
+    return vec;
+  };
+
+  CONSTEXPR auto vec = create();
+  STATIC_REQUIRE(vec.size() == 4);
+  STATIC_REQUIRE(vec[0] == 1);
+  STATIC_REQUIRE(vec[1] == 0);
+  STATIC_REQUIRE(vec[3] == 0);
+}
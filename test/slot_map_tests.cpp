@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/slot_map.hpp>
+
+#include <string>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+constexpr inline std::size_t MAP_SIZE = 8;
+
+TEST_CASE("[slot_handle] packs index and generation")
+{
+  CONSTEXPR auto handle = lefticus::tools::slot_handle32{ 5, 3 };
+  STATIC_REQUIRE(handle.index() == 5);
+  STATIC_REQUIRE(handle.generation() == 3);
+  STATIC_REQUIRE(handle.next_generation().generation() == 4);
+  STATIC_REQUIRE(handle.next_generation().index() == 5);
+  STATIC_REQUIRE(sizeof(lefticus::tools::slot_handle32) == sizeof(std::uint32_t));
+  STATIC_REQUIRE(sizeof(lefticus::tools::slot_handle64) == sizeof(std::uint64_t));
+}
+
+TEST_CASE("[simple_stack_slot_map] starts empty")
+{
+  STATIC_REQUIRE(lefticus::tools::simple_stack_slot_map<int, MAP_SIZE>{}.empty());
+  STATIC_REQUIRE(!lefticus::tools::simple_stack_slot_map<int, MAP_SIZE>{}.contains({}));
+}
+
+TEST_CASE("[simple_stack_slot_map] insert and lookup")
+{
+  const auto create = []() {
+    lefticus::tools::simple_stack_slot_map<int, MAP_SIZE> map;
+    const auto first = map.insert(1);
+    const auto second = map.insert(2);
+    map[second] += 40;// NOLINT Magic Number
+    return map.at(first) + map.at(second);
+  };
+
+  STATIC_REQUIRE(create() == 43);
+}
+
+TEST_CASE("[simple_stack_slot_map] erased handles become stale")
+{
+  const auto erase = []() {
+    lefticus::tools::simple_stack_slot_map<int, MAP_SIZE> map;
+    const auto first = map.insert(1);
+    const auto erased = map.erase(first);
+    const auto second = map.insert(2);
+
+    // the slot is reused, but with a new generation
+    return erased && second.index() == first.index() && !map.contains(first) && map.find(first) == nullptr
+           && !map.erase(first) && map.at(second) == 2;
+  };
+
+  STATIC_REQUIRE(erase());
+}
+
+TEST_CASE("[simple_stack_slot_map] values stay densely packed")
+{
+  const auto erase_middle = []() {
+    lefticus::tools::simple_stack_slot_map<int, MAP_SIZE> map;
+    const auto first = map.insert(1);
+    const auto second = map.insert(2);
+    const auto third = map.insert(3);
+    map.erase(second);
+
+    int sum = 0;
+    for (const auto value : map) { sum += value; }
+
+    // the last value was moved into the hole, its handle still finds it
+    return sum == 4 && map.size() == 2 && map.at(third) == 3 && map.at(first) == 1
+           && map.handles()[1] == third;
+  };
+
+  STATIC_REQUIRE(erase_middle());
+}
+
+TEST_CASE("[simple_stack_slot_map] clear invalidates all handles")
+{
+  const auto clear = []() {
+    lefticus::tools::simple_stack_slot_map<int, MAP_SIZE> map;
+    const auto first = map.insert(1);
+    const auto second = map.insert(2);
+    map.clear();
+    const auto third = map.insert(3);
+    return map.empty() == false && !map.contains(first) && !map.contains(second) && map.contains(third);
+  };
+
+  STATIC_REQUIRE(clear());
+}
+
+TEST_CASE("[simple_stack_slot_map] throws when full")
+{
+  lefticus::tools::simple_stack_slot_map<int, 1> map;
+  const auto first = map.insert(1);
+  REQUIRE_THROWS_AS(map.insert(2), std::length_error);
+  REQUIRE(map.erase(first));
+  REQUIRE(map.contains(map.insert(3)));
+  REQUIRE_THROWS_AS(map.at(first), std::out_of_range);
+}
+
+TEST_CASE("[slot_map] growable form with 64 bit handles")
+{
+  lefticus::tools::slot_map<std::string, lefticus::tools::slot_handle64> map;
+
+  const auto hello = map.emplace("hello");
+  const auto world = map.insert(std::string{ "world" });
+  REQUIRE(map.size() == 2);
+
+  map.erase(hello);
+  REQUIRE(map.find(hello) == nullptr);
+  REQUIRE(*map.find(world) == "world");
+  REQUIRE(map.values().front() == "world");
+}
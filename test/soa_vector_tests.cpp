@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/soa_vector.hpp>
+
+#include <algorithm>
+#include <string>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+constexpr inline std::size_t SOA_SIZE = 8;
+
+using particles = lefticus::tools::stack_soa_vector<SOA_SIZE, float, float, int>;
+
+TEST_CASE("[stack_soa_vector] starts empty")
+{
+  STATIC_REQUIRE(particles{}.empty() == true);
+  STATIC_REQUIRE(std::is_same_v<particles::field_type<2>, int>);
+  STATIC_REQUIRE(particles::field_count == 3);
+}
+
+TEST_CASE("[stack_soa_vector] fields are stored in separate columns")
+{
+  const auto create = []() {
+    particles soa;
+    soa.push_back({ 1.0F, 0.5F, 1 });
+    soa.emplace_back(2.0F, 0.25F, 2);
+    return soa;
+  };
+
+  CONSTEXPR auto soa = create();
+  STATIC_REQUIRE(soa.size() == 2);
+  STATIC_REQUIRE(soa.get<0>().size() == 2);
+  STATIC_REQUIRE(soa.get<0>()[1] == 2.0F);
+  STATIC_REQUIRE(soa.column<1>()[0] == 0.5F);
+  STATIC_REQUIRE(soa[1].get<2>() == 2);
+  STATIC_REQUIRE(static_cast<std::tuple<float, float, int>>(soa.back()) == std::tuple{ 2.0F, 0.25F, 2 });
+}
+
+TEST_CASE("[stack_soa_vector] rows support structured bindings")
+{
+  const auto sum = []() {
+    particles soa{ { 1.0F, 0.5F, 1 }, { 2.0F, 0.25F, 2 } };
+    for (auto [position, velocity, id] : soa) { position += velocity * static_cast<float>(id); }
+
+    float total = 0;
+    for (const auto row : soa) { total += row.get<0>(); }
+    return total;
+  };
+
+  STATIC_REQUIRE(sum() == 4.0F);
+}
+
+TEST_CASE("[stack_soa_vector] for_each touches only the selected columns")
+{
+  const auto integrate = []() {
+    particles soa{ { 1.0F, 0.5F, 1 }, { 2.0F, 0.25F, 2 } };
+    soa.for_each<0, 1>([](float &position, const float velocity) { position += velocity; });
+    return soa;
+  };
+
+  CONSTEXPR auto soa = integrate();
+  STATIC_REQUIRE(soa.get<0>()[0] == 1.5F);
+  STATIC_REQUIRE(soa.get<0>()[1] == 2.25F);
+  STATIC_REQUIRE(soa.get<1>()[0] == 0.5F);
+}
+
+TEST_CASE("[stack_soa_vector] row assignment writes through")
+{
+  const auto swap_rows = []() {
+    particles soa{ { 1.0F, 0.5F, 1 }, { 2.0F, 0.25F, 2 } };
+    const std::tuple<float, float, int> first = soa[0];
+    soa[0] = soa[1];
+    soa[1] = first;
+    return soa;
+  };
+
+  CONSTEXPR auto soa = swap_rows();
+  STATIC_REQUIRE(soa.get<2>()[0] == 2);
+  STATIC_REQUIRE(soa.get<2>()[1] == 1);
+}
+
+TEST_CASE("[stack_soa_vector] iterators are random access")
+{
+  CONSTEXPR particles soa{ { 1.0F, 0.5F, 1 }, { 2.0F, 0.25F, 2 }, { 3.0F, 0.125F, 3 } };
+  STATIC_REQUIRE(std::random_access_iterator<particles::const_iterator>);
+  STATIC_REQUIRE(soa.end() - soa.begin() == 3);
+  STATIC_REQUIRE((*(soa.begin() + 2)).get<2>() == 3);
+  STATIC_REQUIRE(soa.begin()[1].get<2>() == 2);
+}
+
+TEST_CASE("[stack_soa_vector] resize grows and shrinks every column")
+{
+  const auto resized = []() {
+    particles soa;
+    soa.emplace_back(1.0F, 0.5F, 1);
+    soa.resize(4);
+    const bool grown = soa.size() == 4 && soa.get<1>().size() == 4 && soa[0].get<2>() == 1 && soa[2].get<0>() == 0.0F;
+    soa.get<2>()[2] = 7;// NOLINT Magic Number
+    soa.resize(2);
+    const bool shrunk = soa.size() == 2 && soa.get<2>().size() == 2 && soa[0].get<2>() == 1;
+    soa.resize(3);
+    // regrown elements are value initialized again, not left over
+    return grown && shrunk && soa.size() == 3 && soa[2].get<2>() == 0;
+  };
+
+  STATIC_REQUIRE(resized());
+  CHECK_THROWS_AS(particles{}.resize(SOA_SIZE + 1), std::length_error);
+}
+
+TEST_CASE("[stack_soa_vector] throws when full")
+{
+  lefticus::tools::stack_soa_vector<1, int, char> soa;
+  soa.emplace_back(1, 'a');
+  REQUIRE_THROWS_AS(soa.emplace_back(2, 'b'), std::length_error);
+  REQUIRE(soa.size() == 1);
+  REQUIRE_THROWS_AS(soa.at(1), std::out_of_range);
+}
+
+TEST_CASE("[soa_vector] growable form has the same interface")
+{
+  lefticus::tools::soa_vector<std::string, int> soa;
+  soa.emplace_back("hello", 1);
+  soa.push_back({ "world", 2 });
+  soa.for_each<1>([](int &value) { value *= 10; });// NOLINT Magic Number
+
+  REQUIRE(soa.size() == 2);
+  REQUIRE(soa.get<0>()[1] == "world");
+  REQUIRE(soa.at(1).get<1>() == 20);
+  soa.pop_back();
+  REQUIRE(soa.size() == 1);
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/lambda_coroutines.hpp>
+#include <lefticus/tools/split.hpp>
+
+#include <string>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+TEST_CASE("[split] is a forward range")
+{
+  using view = decltype(lefticus::tools::split(std::string_view{}, ','));
+  STATIC_REQUIRE(std::ranges::forward_range<view>);
+  STATIC_REQUIRE(std::ranges::view<view>);
+}
+
+TEST_CASE("[split] splits on a single character")
+{
+  CONSTEXPR auto pieces = lefticus::tools::split_to<8>("a,bb,,ccc,", ',');
+  STATIC_REQUIRE(pieces.size() == 5);
+  STATIC_REQUIRE(pieces[0] == "a");
+  STATIC_REQUIRE(pieces[1] == "bb");
+  STATIC_REQUIRE(pieces[2].empty());
+  STATIC_REQUIRE(pieces[3] == "ccc");
+  STATIC_REQUIRE(pieces[4].empty());
+}
+
+TEST_CASE("[split] empty text is one empty piece")
+{
+  STATIC_REQUIRE(lefticus::tools::split_to<2>("", ',').size() == 1);
+  STATIC_REQUIRE(lefticus::tools::split_to<2>("", ',', { .skip_empty = true }).empty());
+}
+
+TEST_CASE("[split] splits on any of a set of characters")
+{
+  CONSTEXPR auto pieces = lefticus::tools::split_to<8>("GET /index.html HTTP/1.1\r\n", " \r\n", { .skip_empty = true });
+  STATIC_REQUIRE(pieces.size() == 3);
+  STATIC_REQUIRE(pieces[0] == "GET");
+  STATIC_REQUIRE(pieces[1] == "/index.html");
+  STATIC_REQUIRE(pieces[2] == "HTTP/1.1");
+}
+
+TEST_CASE("[split] runtime scan agrees with constant evaluation")
+{
+  // long enough that the delimiters fall in several 8 character words
+  constexpr std::string_view csv{ "name,value\nalpha,1\nbeta,22\n\xe9gamma,333\nlast field without newline" };
+  constexpr auto expected = lefticus::tools::split_to<16>(csv, ",\n");
+  const auto pieces = lefticus::tools::split_to<16>(csv, ",\n");
+  CHECK(pieces == expected);
+  CHECK(pieces.size() == 9);// NOLINT Magic Number
+  CHECK(pieces[6] == "\xe9gamma");// NOLINT Magic Number
+
+  constexpr std::string_view request{ "POST /a/rather/long/path/to/a/resource?query=1 HTTP/1.1\r\nHost: x\r\n" };
+  constexpr auto expected_words = lefticus::tools::split_to<8>(request, " \r\n", { .skip_empty = true });
+  const auto words = lefticus::tools::split_to<8>(request, " \r\n", { .skip_empty = true });
+  CHECK(words == expected_words);
+  CHECK(words.size() == 5);// NOLINT Magic Number
+}
+
+TEST_CASE("[split] max_splits leaves the rest of the text in the last piece")
+{
+  CONSTEXPR auto pieces = lefticus::tools::split_to<4>("key=value=more", '=', { .max_splits = 1 });
+  STATIC_REQUIRE(pieces.size() == 2);
+  STATIC_REQUIRE(pieces[0] == "key");
+  STATIC_REQUIRE(pieces[1] == "value=more");
+
+  CONSTEXPR auto skipped =
+    lefticus::tools::split_to<4>("  a   b c  ", ' ', { .max_splits = 1, .skip_empty = true });// NOLINT Magic Number
+  STATIC_REQUIRE(skipped.size() == 2);
+  STATIC_REQUIRE(skipped[0] == "a");
+  STATIC_REQUIRE(skipped[1] == "b c  ");
+
+  STATIC_REQUIRE(lefticus::tools::split_to<4>("a,b", ',', { .max_splits = 0 })[0] == "a,b");
+}
+
+TEST_CASE("[split] pieces view the original text")
+{
+  const std::string text{ "alpha beta" };
+  std::vector<std::string_view> pieces;
+  for (const auto piece : lefticus::tools::split(text, ' ')) { pieces.push_back(piece); }
+
+  REQUIRE(pieces.size() == 2);
+  CHECK(pieces[0].data() == text.data());
+  CHECK(pieces[1].data() == text.data() + 6);// NOLINT Magic Number
+}
+
+TEST_CASE("[split] iterators can be copied and compared")
+{
+  const auto view = lefticus::tools::split("a,b,c", ',');
+  auto first = view.begin();
+  const auto copy = first;
+  ++first;
+  CHECK(*copy == "a");
+  CHECK(*first == "b");
+  CHECK(copy != first);
+  CHECK(std::ranges::distance(view) == 3);
+  CHECK(std::ranges::next(view.begin(), 1) == first);
+}
+
+TEST_CASE("[split] split_to throws when there are too many pieces")
+{
+  CHECK_THROWS_AS(lefticus::tools::split_to<2>("a,b,c", ','), std::length_error);
+}
+
+TEST_CASE("[split] generator works with while_has_value")
+{
+  std::vector<std::string_view> pieces;
+  for (const auto piece :
+    lefticus::tools::lambda_coroutines::while_has_value(lefticus::tools::split_generator("x;y;;z", ";"))) {
+    pieces.push_back(piece);
+  }
+
+  REQUIRE(pieces.size() == 4);
+  CHECK(pieces[0] == "x");
+  CHECK(pieces[2].empty());
+  CHECK(pieces[3] == "z");
+}
+
+TEST_CASE("[split] generator is constexpr capable")
+{
+  constexpr auto count = []() {
+    auto next = lefticus::tools::split_generator("1 2 3", ' ');
+    std::size_t result = 0;
+    while (next()) { ++result; }
+    return result;
+  };
+  STATIC_REQUIRE(count() == 3);
+}
+
+TEST_CASE("[split] wide strings use basic_split_view directly")
+{
+  const lefticus::tools::basic_split_view view{ lefticus::tools::basic_splitter{
+    std::wstring_view{ L"a-b+c" }, lefticus::tools::any_of_delimiter<wchar_t>{ L"+-" }, {} } };
+  CHECK(std::ranges::distance(view) == 3);
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/stack_arena.hpp>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+
+TEST_CASE("[stack_arena] std::pmr containers allocate from the arena")
+{
+  lefticus::tools::stack_arena<1024> arena;// NOLINT Magic Number
+
+  std::pmr::vector<int> vec{ &arena };
+  vec.reserve(10);// NOLINT Magic Number
+  vec.push_back(42);// NOLINT Magic Number
+
+  REQUIRE(arena.allocation_count() == 1);
+  REQUIRE(arena.bytes_in_use() == 10 * sizeof(int));
+  REQUIRE(arena.bytes_reserved() >= 10 * sizeof(int));
+  REQUIRE(vec[0] == 42);
+}
+
+TEST_CASE("[stack_arena] high water mark survives deallocation")
+{
+  lefticus::tools::stack_arena<1024> arena;// NOLINT Magic Number
+
+  {
+    std::pmr::string str{ "a string long enough to need an allocation", &arena };
+    REQUIRE(arena.bytes_in_use() > 0);
+  }
+
+  REQUIRE(arena.bytes_in_use() == 0);
+  // the string was the most recent allocation, so its memory was handed back
+  REQUIRE(arena.bytes_reserved() == 0);
+  REQUIRE(arena.high_water_mark() > 0);
+}
+
+TEST_CASE("[stack_arena] throws std::bad_alloc when exhausted")
+{
+  lefticus::tools::stack_arena<64> arena;// NOLINT Magic Number
+
+  std::pmr::vector<char> vec{ &arena };
+  vec.reserve(64);// NOLINT Magic Number
+  REQUIRE_THROWS_AS(std::pmr::vector<char>(1, 'a', &arena), std::bad_alloc);
+}
+
+TEST_CASE("[stack_arena] release resets the arena")
+{
+  lefticus::tools::stack_arena<128> arena;// NOLINT Magic Number
+
+  [[maybe_unused]] void *first = arena.allocate(100);// NOLINT Magic Number
+  REQUIRE_THROWS_AS(arena.allocate(100), std::bad_alloc);// NOLINT Magic Number
+
+  arena.release();
+  REQUIRE(arena.bytes_reserved() == 0);
+  REQUIRE(arena.allocate(100) == first);// NOLINT Magic Number
+}
+
+TEST_CASE("[stack_arena] allocations are aligned")
+{
+  lefticus::tools::stack_arena<256> arena;// NOLINT Magic Number
+
+  [[maybe_unused]] void *byte = arena.allocate(1, 1);
+  void *aligned = arena.allocate(8, 64);// NOLINT Magic Number
+  REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);// NOLINT
+}
+
+TEST_CASE("[stack_arena] free_list mode reuses deallocated blocks")
+{
+  lefticus::tools::stack_arena<256, lefticus::tools::arena_mode::free_list> arena;// NOLINT Magic Number
+
+  void *first = arena.allocate(32);// NOLINT Magic Number
+  [[maybe_unused]] void *second = arena.allocate(32);// NOLINT Magic Number
+  const auto reserved = arena.bytes_reserved();
+
+  arena.deallocate(first, 32);// NOLINT Magic Number
+  REQUIRE(arena.allocate(16) == first);// NOLINT Magic Number
+  REQUIRE(arena.bytes_reserved() == reserved);
+}
+
+TEST_CASE("[stack_arena] free_list mode never loses part of a block")
+{
+  lefticus::tools::stack_arena<256, lefticus::tools::arena_mode::free_list> arena;// NOLINT Magic Number
+
+  void *first = arena.allocate(48);// NOLINT Magic Number
+  [[maybe_unused]] void *second = arena.allocate(8);// NOLINT Magic Number
+  const auto reserved = arena.bytes_reserved();
+  arena.deallocate(first, 48);// NOLINT Magic Number
+
+  // the 8 bytes left over are too small to go back on the free list by
+  // themselves, so they stay with the block and come back with it
+  REQUIRE(arena.allocate(40) == first);// NOLINT Magic Number
+  REQUIRE(arena.bytes_in_use() == 48);// NOLINT Magic Number
+  arena.deallocate(first, 40);// NOLINT Magic Number
+  REQUIRE(arena.allocate(48) == first);// NOLINT Magic Number
+  arena.deallocate(first, 48);// NOLINT Magic Number
+
+  // a split leaves a tail that is reused
+  REQUIRE(arena.allocate(24) == first);// NOLINT Magic Number
+  REQUIRE(arena.allocate(16) != nullptr);// NOLINT Magic Number
+  REQUIRE(arena.bytes_reserved() == reserved);
+}
+
+TEST_CASE("[stack_arena] monotonic mode does not reuse interior blocks")
+{
+  lefticus::tools::stack_arena<256> arena;// NOLINT Magic Number
+
+  void *first = arena.allocate(32);// NOLINT Magic Number
+  [[maybe_unused]] void *second = arena.allocate(32);// NOLINT Magic Number
+
+  arena.deallocate(first, 32);// NOLINT Magic Number
+  REQUIRE(arena.allocate(16) != first);// NOLINT Magic Number
+}
+
+namespace {
+lefticus::tools::stack_arena<1024> static_arena;// NOLINT Magic Number
+}
+
+TEST_CASE("[arena_allocator] stateless allocator works with std containers")
+{
+  static_arena.release();
+
+  {
+    std::vector<int, lefticus::tools::arena_allocator<int, static_arena>> vec;
+    vec.push_back(1);
+    vec.push_back(2);
+
+    STATIC_REQUIRE(sizeof(vec) == sizeof(std::vector<int>));
+    REQUIRE(vec.size() == 2);
+    REQUIRE(static_arena.bytes_in_use() > 0);
+  }
+
+  REQUIRE(static_arena.bytes_in_use() == 0);
+}
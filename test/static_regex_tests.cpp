@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/static_regex.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using lefticus::tools::static_regex;
+
+TEST_CASE("[static_regex] match requires the whole string")
+{
+  using re = static_regex<"[a-z]+=\\d+">;
+  STATIC_REQUIRE(re::match("answer=42"));
+  STATIC_REQUIRE(!re::match("answer=42!"));
+  STATIC_REQUIRE(!re::match("answer="));
+  STATIC_REQUIRE(!re::match("=42"));
+  STATIC_REQUIRE(!re::match(""));
+}
+
+TEST_CASE("[static_regex] quantifiers and alternation")
+{
+  STATIC_REQUIRE(static_regex<"ab*c">::match("ac"));
+  STATIC_REQUIRE(static_regex<"ab*c">::match("abbbc"));
+  STATIC_REQUIRE(!static_regex<"ab+c">::match("ac"));
+  STATIC_REQUIRE(static_regex<"ab+c">::match("abc"));
+  STATIC_REQUIRE(static_regex<"colou?r">::match("color"));
+  STATIC_REQUIRE(static_regex<"colou?r">::match("colour"));
+  STATIC_REQUIRE(static_regex<"cat|dog|bird">::match("dog"));
+  STATIC_REQUIRE(!static_regex<"cat|dog|bird">::match("cow"));
+  STATIC_REQUIRE(static_regex<"(ab|cd)*e">::match("abcdabe"));
+  STATIC_REQUIRE(!static_regex<"(?:ab|cd)*e">::match("abce"));
+  STATIC_REQUIRE(static_regex<"">::match(""));
+  STATIC_REQUIRE(static_regex<"a|">::match(""));
+}
+
+TEST_CASE("[static_regex] classes and escapes")
+{
+  STATIC_REQUIRE(static_regex<"[^0-9]+">::match("abc"));
+  STATIC_REQUIRE(!static_regex<"[^0-9]+">::match("a1c"));
+  STATIC_REQUIRE(static_regex<"[-a]+">::match("a-a"));
+  STATIC_REQUIRE(static_regex<"[]]">::match("]"));
+  STATIC_REQUIRE(static_regex<"[\\d.]+">::match("3.14"));
+  STATIC_REQUIRE(static_regex<"\\w+\\s\\W">::match("word_1 !"));
+  STATIC_REQUIRE(static_regex<"\\D\\S">::match("a!"));
+  STATIC_REQUIRE(static_regex<"a\\.b\\*">::match("a.b*"));
+  STATIC_REQUIRE(!static_regex<"a\\.b">::match("axb"));
+  STATIC_REQUIRE(static_regex<"a.b">::match("axb"));
+  STATIC_REQUIRE(!static_regex<"a.b">::match("a\nb"));
+}
+
+TEST_CASE("[static_regex] search finds the leftmost-longest match")
+{
+  using re = static_regex<"\\d+">;
+  CONSTEXPR auto found = re::search("abc 123 45");
+  STATIC_REQUIRE(found.has_value());
+  STATIC_REQUIRE(*found == "123");
+  STATIC_REQUIRE(!re::search("no digits").has_value());
+
+  // POSIX rules, not the first alternative
+  STATIC_REQUIRE(*static_regex<"a|ab">::search("xab") == "ab");
+}
+
+TEST_CASE("[static_regex] search only tries starts before the earliest match end")
+{
+  // the earliest match to end is "c", but "abcd" starts further left
+  STATIC_REQUIRE(*static_regex<"abcd|c">::search("xabcd") == "abcd");
+  STATIC_REQUIRE(*static_regex<"a*b|c">::search("aaac") == "c");
+  STATIC_REQUIRE(*static_regex<"a*b">::search("xaab") == "aab");
+  STATIC_REQUIRE(*static_regex<"b*">::search("abc", 1) == "b");
+  STATIC_REQUIRE(static_regex<"a*b">::search("xyz", 4) == std::nullopt);
+
+  // a text with no match is one pass of the search DFA
+  const std::string long_run(100000, 'a');// NOLINT Magic Number
+  CHECK(!static_regex<"a*b">::search(long_run).has_value());
+  CHECK(static_regex<"a*b">::search(long_run + "b")->size() == long_run.size() + 1);
+
+  // too many search states, so search tries every start instead
+  using large = static_regex<"a[ab][ab][ab][ab][ab][ab][ab][ab]">;
+  STATIC_REQUIRE(large::search_accepts.empty());
+  STATIC_REQUIRE(*large::search("bbaababababb") == "aabababab");
+}
+
+TEST_CASE("[static_regex] anchors")
+{
+  STATIC_REQUIRE(static_regex<"^ab">::search("abab")->data() == std::string_view{ "abab" }.data());
+  STATIC_REQUIRE(!static_regex<"^ab">::search("cab").has_value());
+  STATIC_REQUIRE(*static_regex<"b+$">::search("abbabb") == "bb");
+  STATIC_REQUIRE(!static_regex<"a$">::search("ab").has_value());
+  STATIC_REQUIRE(static_regex<"a\\$">::match("a$"));
+}
+
+TEST_CASE("[static_regex] find_all")
+{
+  constexpr auto count = [](const std::string_view text) {
+    std::size_t result = 0;
+    std::size_t total = 0;
+    for (const auto match : static_regex<"[a-z]+">::find_all(text)) {
+      ++result;
+      total += match.size();
+    }
+    return result * 100 + total;
+  };
+
+  STATIC_REQUIRE(count("one two, three!") == 311);
+  STATIC_REQUIRE(count("") == 0);
+  STATIC_REQUIRE(count("123") == 0);
+
+  // empty matches advance by one
+  constexpr auto empty_matches = [] {
+    std::size_t result = 0;
+    for ([[maybe_unused]] const auto match : static_regex<"x*">::find_all("ab")) { ++result; }
+    return result;
+  }();
+  STATIC_REQUIRE(empty_matches == 3);
+
+  STATIC_REQUIRE(std::forward_iterator<decltype(static_regex<"a">::find_all("a").begin())>);
+}
+
+TEST_CASE("[static_regex] tables are small")
+{
+  using re = static_regex<"[a-z]+=\\d+">;
+  STATIC_REQUIRE(sizeof(re::state_type) == 1);
+  STATIC_REQUIRE(re::class_count == 4);
+  STATIC_REQUIRE(re::accepts.size() == 5);
+}
@@ -72,6 +72,19 @@ TEST_CASE("[to_right_sized_array] produces an array of the correct size")
   STATIC_REQUIRE(sizeof(result) == 3 * sizeof(double));
 }
 
+#if __cpp_lib_constexpr_vector >= 201907L
+TEST_CASE("[to_right_sized_array] has no upper bound on size")
+{
+  CONSTEXPR auto result = lefticus::tools::to_right_sized_array([]() {
+    std::vector<int> values;
+    for (int value = 0; value < 20000; ++value) { values.push_back(value); }// NOLINT Magic Number
+    return values;
+  });
+  STATIC_REQUIRE(result.size() == 20000);// NOLINT Magic Number
+  STATIC_REQUIRE(result.back() == 19999);// NOLINT Magic Number
+}
+#endif
+
 constexpr auto make_string_like()
 {
   lefticus::tools::simple_stack_string<10> result{ "Hello" };
@@ -186,3 +199,282 @@ TEST_CASE("[minimized_stackify] works with std::vector, std::string")// NOLINT (
 #endif
 
 #endif
+
+
+#if __cpp_lib_constexpr_vector >= 201907L
+TEST_CASE("[to_sorted_span] sorts at compile time")
+{
+  CONSTEXPR auto sorted = lefticus::tools::to_sorted_span([]() { return std::vector{ 5, 3, 9, 1, 3 }; });
+  STATIC_REQUIRE(sorted.size() == 5);// NOLINT Magic Number
+  STATIC_REQUIRE(std::ranges::is_sorted(sorted));
+
+  CONSTEXPR auto descending =
+    lefticus::tools::to_sorted_span([]() { return std::vector{ 5, 3, 9, 1, 3 }; }, std::ranges::greater{});
+  STATIC_REQUIRE(descending.front() == 9);// NOLINT Magic Number
+  STATIC_REQUIRE(descending.back() == 1);
+}
+
+TEST_CASE("[to_sorted_unique_span] sorts and removes duplicates")
+{
+  CONSTEXPR auto unique = lefticus::tools::to_sorted_unique_span([]() { return std::vector{ 5, 3, 9, 1, 3, 5, 5 }; });
+  STATIC_REQUIRE(unique.size() == 4);
+  STATIC_REQUIRE(unique[0] == 1);
+  STATIC_REQUIRE(unique[1] == 3);
+  STATIC_REQUIRE(unique[2] == 5);// NOLINT Magic Number
+  STATIC_REQUIRE(unique[3] == 9);// NOLINT Magic Number
+}
+
+TEST_CASE("[static_lookup] finds keys in a table sorted by projection")
+{
+  using entry = lefticus::tools::pair<int, char>;
+  constexpr auto key = [](const entry &value) { return value.first; };
+  CONSTEXPR auto table = lefticus::tools::to_sorted_unique_span(
+    []() {
+      return std::vector<entry>{ { 42, 'a' }, { 7, 'b' }, { 19, 'c' }, { 7, 'd' }, { 100, 'e' } };// NOLINT
+    },
+    std::ranges::less{},
+    key);
+
+  CONSTEXPR lefticus::tools::static_lookup lookup{ table, std::ranges::less{}, key };
+
+  STATIC_REQUIRE(lookup.size() == 4);
+  STATIC_REQUIRE(lookup.find(19)->second == 'c');// NOLINT Magic Number
+  STATIC_REQUIRE(lookup.find(7)->second == 'b');// NOLINT Magic Number
+  STATIC_REQUIRE(lookup.find(8) == nullptr);// NOLINT Magic Number
+  STATIC_REQUIRE(lookup.lower_bound(0) == 0);
+  STATIC_REQUIRE(lookup.lower_bound(20) == 2);// NOLINT Magic Number
+  STATIC_REQUIRE(lookup.lower_bound(1000) == 4);// NOLINT Magic Number
+  STATIC_REQUIRE(!lookup.contains(101));// NOLINT Magic Number
+}
+
+TEST_CASE("[static_lookup] lower_bound agrees with std::ranges::lower_bound")
+{
+  constexpr auto values = lefticus::tools::to_sorted_span([]() {
+    std::vector<int> result;
+    for (int value = 0; value < 100; ++value) { result.push_back((value * 37) % 101); }// NOLINT Magic Number
+    return result;
+  });
+  const lefticus::tools::static_lookup lookup{ values };
+
+  for (std::size_t size = 0; size <= values.size(); ++size) {
+    const lefticus::tools::static_lookup prefix{ values.first(size) };
+    for (int key = -1; key < 103; ++key) {// NOLINT Magic Number
+      const auto expected = std::ranges::lower_bound(values.first(size), key) - values.begin();
+      CHECK(prefix.lower_bound(key) == static_cast<std::size_t>(expected));
+    }
+  }
+  CHECK(lookup.contains(36));// NOLINT Magic Number
+}
+#endif
+
+
+#if __cpp_lib_constexpr_vector >= 201907L && __cpp_lib_constexpr_string >= 201907L
+TEST_CASE("[to_csr] flattens ragged vectors")
+{
+  CONSTEXPR auto graph = lefticus::tools::to_csr([]() {
+    return std::vector<std::vector<int>>{ { 1, 2 }, {}, { 0 }, { 0, 1, 2, 3, 4, 5 } };// NOLINT Magic Number
+  });
+
+  STATIC_REQUIRE(graph.size() == 4);
+  STATIC_REQUIRE(graph.values.size() == 9);// NOLINT Magic Number
+  STATIC_REQUIRE(std::is_same_v<decltype(graph)::offset_type, std::uint8_t>);
+  STATIC_REQUIRE(graph[0].size() == 2);
+  STATIC_REQUIRE(graph[1].empty());
+  STATIC_REQUIRE(graph[2][0] == 0);
+  STATIC_REQUIRE(graph[3].back() == 5);// NOLINT Magic Number
+
+  std::size_t edges = 0;
+  for (const auto row : graph) { edges += row.size(); }
+  CHECK(edges == 9);// NOLINT Magic Number
+  CHECK_THROWS_AS(graph.at(4), std::out_of_range);
+}
+
+TEST_CASE("[to_csr] rows of strings are string_views")
+{
+  CONSTEXPR auto words = lefticus::tools::to_csr([]() {
+    std::vector<std::string> result{ "a", "ragged", "list of strings" };
+    result.emplace_back(300, 'x');// NOLINT Magic Number
+    return result;
+  });
+
+  STATIC_REQUIRE(std::is_same_v<decltype(words[0]), std::string_view>);
+  STATIC_REQUIRE(std::is_same_v<decltype(words)::offset_type, std::uint16_t>);
+  STATIC_REQUIRE(words[1] == "ragged");
+  STATIC_REQUIRE(words[2] == "list of strings");
+  STATIC_REQUIRE(words[3].size() == 300);// NOLINT Magic Number
+  STATIC_REQUIRE(words.values.size() == 1 + 6 + 15 + 300);// NOLINT Magic Number
+}
+#endif
+
+
+#if __cpp_lib_constexpr_vector >= 201907L && __cpp_lib_constexpr_string >= 201907L
+namespace {
+constexpr std::vector<std::string> make_identifiers()
+{
+  return { "begin", "end", "cend", "size", "resize", "end", "size", "" };
+}
+}// namespace
+
+TEST_CASE("[to_string_table] packs strings back to back")
+{
+  CONSTEXPR auto table = lefticus::tools::to_string_table([]() { return make_identifiers(); });
+
+  STATIC_REQUIRE(table.size() == 8);// NOLINT Magic Number
+  STATIC_REQUIRE(table.blob.size() == 5 + 3 + 4 + 4 + 6 + 3 + 4);// NOLINT Magic Number
+  STATIC_REQUIRE(table[0] == "begin");
+  STATIC_REQUIRE(table[4] == "resize");// NOLINT Magic Number
+  STATIC_REQUIRE(table[7].empty());// NOLINT Magic Number
+  STATIC_REQUIRE(std::is_same_v<decltype(table)::value_type, std::string_view>);
+  STATIC_REQUIRE(std::random_access_iterator<decltype(table.begin())>);
+  STATIC_REQUIRE(std::ranges::random_access_range<decltype(table)>);
+}
+
+TEST_CASE("[to_string_table] deduplicates and shares suffixes")
+{
+  static constexpr lefticus::tools::string_table_options options{ .null_terminated = true, .deduplicate = true };
+  CONSTEXPR auto table = lefticus::tools::to_string_table<options>([]() { return make_identifiers(); });
+
+  STATIC_REQUIRE(table.size() == 8);// NOLINT Magic Number
+  // "end" is stored within "cend", "size" within "resize" and "" as any terminator
+  STATIC_REQUIRE(table.blob.size() == 6 + 5 + 7);// NOLINT Magic Number
+
+  const auto identifiers = make_identifiers();
+  for (std::size_t index = 0; index < identifiers.size(); ++index) {
+    CHECK(table[index] == identifiers[index]);
+    CHECK(std::string_view{ table.c_str(index) } == identifiers[index]);
+  }
+
+  std::size_t total = 0;
+  for (const auto str : table) { total += str.size(); }
+  CHECK(total == 29);// NOLINT Magic Number
+  CHECK(table.end() - table.begin() == 8);// NOLINT Magic Number
+  CHECK(table.begin()[1] == "end");
+}
+#endif
+
+
+#if __cpp_lib_constexpr_vector >= 201907L && __cpp_lib_constexpr_string >= 201907L
+namespace {
+constexpr std::vector<std::string> make_keywords()
+{
+  return { "if", "in", "int", "inline", "for", "float", "return", "in" };
+}
+}// namespace
+
+TEST_CASE("[to_keyword_matcher] exact matches")
+{
+  CONSTEXPR auto keywords = lefticus::tools::to_keyword_matcher([]() { return make_keywords(); });
+  using matcher = std::remove_cvref_t<decltype(keywords)>;
+
+  STATIC_REQUIRE(keywords.match("if") == 0);
+  STATIC_REQUIRE(keywords.match("in") == 1);
+  STATIC_REQUIRE(keywords.match("int") == 2);
+  STATIC_REQUIRE(keywords.match("inline") == 3);
+  STATIC_REQUIRE(keywords.match("float") == 5);// NOLINT Magic Number
+  STATIC_REQUIRE(keywords.match("return") == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(keywords.match("inl") == matcher::npos);
+  STATIC_REQUIRE(keywords.match("i") == matcher::npos);
+  STATIC_REQUIRE(keywords.match("") == matcher::npos);
+  STATIC_REQUIRE(keywords.match("inlined") == matcher::npos);
+  STATIC_REQUIRE(!keywords.contains("While"));
+
+  // 'i', 'n', 'f', ... each need their own column, every unused byte shares one
+  STATIC_REQUIRE(keywords.class_count < 20);// NOLINT Magic Number
+}
+
+TEST_CASE("[to_keyword_matcher] longest prefix")
+{
+  CONSTEXPR auto keywords = lefticus::tools::to_keyword_matcher([]() { return make_keywords(); });
+
+  STATIC_REQUIRE(keywords.longest_prefix("integer").keyword == 2);
+  STATIC_REQUIRE(keywords.longest_prefix("integer").length == 3);
+  STATIC_REQUIRE(keywords.longest_prefix("inlin").keyword == 1);
+  STATIC_REQUIRE(keywords.longest_prefix("inline void").length == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(!keywords.longest_prefix("while"));
+  STATIC_REQUIRE(!keywords.longest_prefix(""));
+
+  const std::string input{ "returning" };
+  CHECK(keywords.longest_prefix(input).keyword == 6);// NOLINT Magic Number
+  CHECK(keywords.match(std::string_view{ input }.substr(0, 6)) == 6);// NOLINT Magic Number
+}
+
+TEST_CASE("[to_keyword_matcher] empty keyword and high bytes")
+{
+  CONSTEXPR auto keywords = lefticus::tools::to_keyword_matcher(
+    []() { return std::vector<std::string>{ "", "\xff\xfe", "\xff" }; });
+
+  STATIC_REQUIRE(keywords.match("") == 0);
+  STATIC_REQUIRE(keywords.match("\xff\xfe") == 1);
+  STATIC_REQUIRE(keywords.longest_prefix("x").keyword == 0);
+  STATIC_REQUIRE(keywords.longest_prefix("\xff\xff").keyword == 2);
+}
+#endif
+
+
+#if __cpp_lib_constexpr_vector >= 201907L
+namespace {
+constexpr auto make_samples()
+{
+  std::vector<std::int64_t> result;
+  std::int64_t value = 1'000'000;// NOLINT Magic Number
+  for (int index = 0; index < 1000; ++index) {// NOLINT Magic Number
+    value += (index % 7) - 3;// NOLINT Magic Number
+    result.push_back(value);
+  }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[to_compressed_span] random access and iteration")
+{
+  CONSTEXPR auto samples = lefticus::tools::to_compressed_span([]() { return make_samples(); });
+
+  STATIC_REQUIRE(samples.size() == 1000);
+  STATIC_REQUIRE(samples.block_count() == 16);// NOLINT Magic Number
+  STATIC_REQUIRE(samples[0] == make_samples()[0]);
+  STATIC_REQUIRE(samples[63] == make_samples()[63]);// NOLINT Magic Number
+  STATIC_REQUIRE(samples[64] == make_samples()[64]);// NOLINT Magic Number
+  STATIC_REQUIRE(samples[999] == make_samples()[999]);// NOLINT Magic Number
+  STATIC_REQUIRE(std::ranges::equal(samples, make_samples()));
+  STATIC_REQUIRE(samples.decompress() == make_samples());
+
+  // one byte per small delta, plus the start of each block
+  STATIC_REQUIRE(samples.compressed_size() < samples.size() * sizeof(std::int64_t) / 6);
+
+  CHECK_THROWS_AS(samples.at(1000), std::out_of_range);// NOLINT Magic Number
+}
+
+TEST_CASE("[to_compressed_span] decode_block")
+{
+  CONSTEXPR auto samples = lefticus::tools::to_compressed_span<16>([]() { return make_samples(); });
+
+  constexpr auto last_block = [](const auto &span) {
+    std::array<std::int64_t, 16> buffer{};
+    const auto count = span.decode_block(span.block_count() - 1, buffer);
+    return buffer[count - 1] == make_samples().back() && count == 1000 % 16;
+  };
+  STATIC_REQUIRE(last_block(samples));
+}
+
+TEST_CASE("[to_compressed_span] extreme values and types")
+{
+  constexpr auto make_mixed = []() {
+    return std::vector<std::int32_t>{
+      std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max(), 0, -1, 1
+    };
+  };
+  CONSTEXPR auto mixed = lefticus::tools::to_compressed_span(make_mixed);
+  STATIC_REQUIRE(std::ranges::equal(mixed, make_mixed()));
+  STATIC_REQUIRE(std::forward_iterator<decltype(mixed.begin())>);
+
+  CONSTEXPR auto wide = lefticus::tools::to_compressed_span([]() {
+    return std::vector<std::uint64_t>{ 0, std::numeric_limits<std::uint64_t>::max(), 1 };
+  });
+  STATIC_REQUIRE(wide[1] == std::numeric_limits<std::uint64_t>::max());
+  STATIC_REQUIRE(wide[2] == 1);
+
+  CONSTEXPR auto empty = lefticus::tools::to_compressed_span([]() { return std::vector<std::uint8_t>{}; });
+  STATIC_REQUIRE(empty.empty());
+  STATIC_REQUIRE(empty.begin() == empty.end());
+}
+#endif
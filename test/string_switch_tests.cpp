@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/string_switch.hpp>
+
+#include <string>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+namespace {
+constexpr auto commands = lefticus::tools::make_string_switch("get", "set", "delete", "list", "");
+
+constexpr int dispatch(const std::string_view command)
+{
+  switch (commands(command)) {
+  case commands.index_of("get"):
+    return 1;
+  case commands.index_of("set"):
+    return 2;
+  case commands.index_of("delete"):
+    return 3;
+  case commands.index_of("list"):
+    return 4;
+  case commands.index_of(""):
+    return 5;
+  default:
+    return 0;
+  }
+}
+}// namespace
+
+
+TEST_CASE("[string_switch] finds each case")
+{
+  STATIC_REQUIRE(commands.size() == 5);
+  STATIC_REQUIRE(commands("get") == 0);
+  STATIC_REQUIRE(commands("set") == 1);
+  STATIC_REQUIRE(commands("delete") == 2);
+  STATIC_REQUIRE(commands("list") == 3);
+  STATIC_REQUIRE(commands("") == 4);
+  STATIC_REQUIRE(commands.case_at(2) == "delete");
+}
+
+TEST_CASE("[string_switch] rejects strings that are not cases")
+{
+  using switch_type = std::remove_cvref_t<decltype(commands)>;
+  STATIC_REQUIRE(commands("got") == switch_type::npos);
+  STATIC_REQUIRE(commands("gets") == switch_type::npos);
+  STATIC_REQUIRE(commands("deleted") == switch_type::npos);
+  STATIC_REQUIRE(commands("GET") == switch_type::npos);
+}
+
+TEST_CASE("[string_switch] usable in a switch statement")
+{
+  STATIC_REQUIRE(dispatch("get") == 1);
+  STATIC_REQUIRE(dispatch("delete") == 3);
+  STATIC_REQUIRE(dispatch("") == 5);
+  STATIC_REQUIRE(dispatch("put") == 0);
+
+  const std::string runtime_input{ "list" };
+  CHECK(dispatch(runtime_input) == 4);
+}
+
+TEST_CASE("[string_switch] cases that differ only in the middle use the full hash")
+{
+  static constexpr auto similar = lefticus::tools::make_string_switch("axbcd", "aybcd", "azbcd", "a_bcd");
+  STATIC_REQUIRE(similar("axbcd") == 0);
+  STATIC_REQUIRE(similar("aybcd") == 1);
+  STATIC_REQUIRE(similar("azbcd") == 2);
+  STATIC_REQUIRE(similar("a_bcd") == 3);
+  STATIC_REQUIRE(similar("awbcd") == decltype(similar)::npos);
+}
+
+TEST_CASE("[string_switch] from simple_stack_strings")
+{
+  static constexpr lefticus::tools::simple_stack_string<8> red{ "red" };
+  static constexpr lefticus::tools::simple_stack_string<8> green{ "green" };
+  static constexpr auto colors = lefticus::tools::make_string_switch(red, green, "blue");
+  STATIC_REQUIRE(colors("green") == 1);
+  STATIC_REQUIRE(colors("blue") == 2);
+  STATIC_REQUIRE(colors("yellow") == decltype(colors)::npos);
+}
+
+TEST_CASE("[string_switch] from a callable")
+{
+  static constexpr auto words = lefticus::tools::to_string_switch([] {
+    std::vector<std::string> result;
+    for (const auto *word : { "alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta" }) {
+      result.emplace_back(word);
+    }
+    return result;
+  });
+
+  STATIC_REQUIRE(words.size() == 8);
+  STATIC_REQUIRE(words("alpha") == 0);
+  STATIC_REQUIRE(words("theta") == 7);
+  STATIC_REQUIRE(words("iota") == decltype(words)::npos);
+
+  for (std::size_t index = 0; index < words.size(); ++index) { CHECK(words(words.case_at(index)) == index); }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/unicode.hpp>
+
+#include <string>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+TEST_CASE("[unicode] valid UTF-8")
+{
+  STATIC_REQUIRE(lefticus::tools::is_valid_utf8(std::string_view{ "" }));
+  STATIC_REQUIRE(lefticus::tools::is_valid_utf8(std::string_view{ "plain ascii" }));
+  STATIC_REQUIRE(lefticus::tools::is_valid_utf8(std::u8string_view{ u8"é中\U0001F600" }));
+  STATIC_REQUIRE(lefticus::tools::is_valid_utf8(std::string_view{ "\xed\x9f\xbf\xf4\x8f\xbf\xbf" }));
+}
+
+TEST_CASE("[unicode] invalid UTF-8")
+{
+  using lefticus::tools::find_invalid_unicode;
+  // stray continuation byte
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "ab\x80" }) == 2);
+  // overlong encodings
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "\xc0\xaf" }) == 0);
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "\xe0\x80\xaf" }) == 0);
+  // surrogates
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "x\xed\xa0\x80" }) == 1);
+  // past U+10FFFF
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "\xf4\x90\x80\x80" }) == 0);
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "\xf5\x80\x80\x80" }) == 0);
+  // truncated
+  STATIC_REQUIRE(find_invalid_unicode(std::string_view{ "abc\xe4\xb8" }) == 3);
+}
+
+TEST_CASE("[unicode] runtime ASCII fast path finds errors at any offset")
+{
+  for (std::size_t offset = 0; offset < 40; ++offset) {// NOLINT Magic Number
+    std::string input(64, 'a');// NOLINT Magic Number
+    CHECK(lefticus::tools::is_valid_utf8(input));
+    input[offset] = '\xff';
+    CHECK(lefticus::tools::find_invalid_unicode(std::string_view{ input }) == offset);
+  }
+}
+
+TEST_CASE("[unicode] code points of UTF-8 with replacement of invalid sequences")
+{
+  const auto collect = [](const std::string_view str) {
+    lefticus::tools::basic_simple_stack_string<char32_t, 16> result;
+    for (const auto code_point : lefticus::tools::code_points(str)) { result.push_back(code_point); }
+    return result;
+  };
+
+  CONSTEXPR auto decoded = collect("a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80");
+  STATIC_REQUIRE(decoded == std::u32string_view{ U"aé中\U0001F600" });
+
+  // maximal subparts: the truncated 3 byte sequence is one U+FFFD, then 'b'
+  CONSTEXPR auto replaced = collect("\xe4\xb8"
+                                    "b\x80");
+  STATIC_REQUIRE(replaced == std::u32string_view{ U"�b�" });
+}
+
+TEST_CASE("[unicode] code points of UTF-16")
+{
+  const auto collect = [](const std::u16string_view str) {
+    lefticus::tools::basic_simple_stack_string<char32_t, 16> result;
+    for (const auto code_point : lefticus::tools::code_points(str)) { result.push_back(code_point); }
+    return result;
+  };
+
+  CONSTEXPR auto decoded = collect(u"a\U0001F600");
+  STATIC_REQUIRE(decoded == std::u32string_view{ U"a\U0001F600" });
+
+  constexpr std::array<char16_t, 3> lone_surrogate{ 0xD800, u'x', 0xDC00 };
+  CONSTEXPR auto replaced = collect(std::u16string_view{ lone_surrogate.data(), lone_surrogate.size() });
+  STATIC_REQUIRE(replaced == std::u32string_view{ U"�x�" });
+}
+
+TEST_CASE("[unicode] code_points is a forward range")
+{
+  STATIC_REQUIRE(std::ranges::forward_range<lefticus::tools::code_point_view<char8_t>>);
+  STATIC_REQUIRE(std::ranges::distance(lefticus::tools::code_points(std::u8string_view{ u8"été" })) == 3);
+}
+
+TEST_CASE("[unicode] transcoding round trips")
+{
+  CONSTEXPR lefticus::tools::basic_simple_stack_string utf8{ u8"héllo \U0001F600" };
+  CONSTEXPR auto utf16 = lefticus::tools::to_utf16(utf8);
+  CONSTEXPR auto utf32 = lefticus::tools::to_utf32(utf8);
+
+  STATIC_REQUIRE(utf16 == std::u16string_view{ u"héllo \U0001F600" });
+  STATIC_REQUIRE(utf32 == std::u32string_view{ U"héllo \U0001F600" });
+  STATIC_REQUIRE(lefticus::tools::to_utf8(utf16) == std::u8string_view{ utf8 });
+  STATIC_REQUIRE(lefticus::tools::to_utf8(utf32) == std::u8string_view{ utf8 });
+  STATIC_REQUIRE(lefticus::tools::to_utf16(utf32) == std::u16string_view{ utf16 });
+  STATIC_REQUIRE(lefticus::tools::to_utf32(utf16) == std::u32string_view{ utf32 });
+}
+
+TEST_CASE("[unicode] transcoding capacities cover the worst case")
+{
+  CONSTEXPR lefticus::tools::basic_simple_stack_string<char16_t, 4> utf16{ u"中中中" };
+  CONSTEXPR auto utf8 = lefticus::tools::to_utf8(utf16);
+  STATIC_REQUIRE(utf8.size() == 9);
+  STATIC_REQUIRE(decltype(utf8)::total_capacity == 10);
+
+  CONSTEXPR lefticus::tools::basic_simple_stack_string<char32_t, 3> utf32{ U"\U0001F600\U0001F600" };
+  STATIC_REQUIRE(decltype(lefticus::tools::to_utf8(utf32))::total_capacity == 9);
+  STATIC_REQUIRE(lefticus::tools::to_utf16(utf32).size() == 4);
+}